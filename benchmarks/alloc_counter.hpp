@@ -0,0 +1,50 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replaces global operator new / delete (aligned overloads included) to count every allocation in the process.
+// Include in exactly one translation unit per executable.
+
+namespace klib::bench {
+namespace detail {
+inline std::atomic<std::size_t> g_allocations{}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+} // namespace detail
+
+[[nodiscard]] inline auto allocation_count() -> std::size_t { return detail::g_allocations.load(std::memory_order_relaxed); }
+} // namespace klib::bench
+
+auto operator new(std::size_t const size) -> void* {
+	klib::bench::detail::g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (auto* ret = std::malloc(size == 0 ? 1 : size)) { return ret; } // NOLINT(cppcoreguidelines-no-malloc)
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }				 // NOLINT(cppcoreguidelines-no-malloc)
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); } // NOLINT(cppcoreguidelines-no-malloc)
+
+// over-aligned types (eg alignas(64) nodes and rings).
+auto operator new(std::size_t const size, std::align_val_t const alignment) -> void* {
+	klib::bench::detail::g_allocations.fetch_add(1, std::memory_order_relaxed);
+	auto const align = std::size_t(alignment);
+#if defined(_WIN32)
+	if (auto* ret = _aligned_malloc(std::max(size, std::size_t{1}), align)) { return ret; }
+#else
+	// aligned_alloc requires size to be a multiple of the alignment.
+	auto const rounded = (std::max(size, std::size_t{1}) + align - 1) / align * align;
+	if (auto* ret = std::aligned_alloc(align, rounded)) { return ret; } // NOLINT(cppcoreguidelines-no-malloc)
+#endif
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr, std::align_val_t /*alignment*/) noexcept {
+#if defined(_WIN32)
+	_aligned_free(ptr);
+#else
+	std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+#endif
+}
+
+void operator delete(void* ptr, std::size_t /*size*/, std::align_val_t const alignment) noexcept { operator delete(ptr, alignment); }
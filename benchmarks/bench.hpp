@@ -0,0 +1,42 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <print>
+#include <span>
+#include <string_view>
+
+namespace klib::bench {
+namespace chr = std::chrono;
+
+using Clock = chr::steady_clock;
+using Seconds = chr::duration<double>;
+
+template <std::invocable F>
+[[nodiscard]] auto measure(F func) -> Seconds {
+	auto const start = Clock::now();
+	func();
+	return Clock::now() - start;
+}
+
+template <std::invocable F>
+[[nodiscard]] auto best_of(std::size_t const runs, F func) -> Seconds {
+	auto ret = Seconds::max();
+	for (auto i = std::size_t{}; i < runs; ++i) { ret = std::min(ret, measure(func)); }
+	return ret;
+}
+
+[[nodiscard]] inline auto per_second(std::size_t const count, Seconds const elapsed) -> double { return double(count) / elapsed.count(); }
+
+// sorts samples in place.
+template <typename Type>
+[[nodiscard]] auto percentile(std::span<Type> samples, double const pct) -> Type {
+	if (samples.empty()) { return {}; }
+	std::ranges::sort(samples);
+	auto const index = std::size_t(pct * double(samples.size() - 1) / 100.0);
+	return samples[index];
+}
+
+inline void print_header(std::string_view const title) { std::println("\n== {} ==", title); }
+} // namespace klib::bench
@@ -0,0 +1,116 @@
+#include "bench.hpp"
+#include "klib/channel.hpp"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr auto item_count_v = std::size_t{1'000'000};
+constexpr auto capacity_v = std::size_t{1024};
+constexpr auto batch_size_v = std::size_t{64};
+constexpr auto runs_v = std::size_t{3};
+
+// mutex + vector hand-off, as pipeline stages used before Channel.
+class LockedChannel {
+  public:
+	explicit LockedChannel(std::size_t const capacity) : m_capacity(capacity) {}
+
+	auto send(std::uint64_t const value) -> bool {
+		auto lock = std::unique_lock{m_mutex};
+		m_not_full.wait(lock, [&] { return m_items.size() < m_capacity || m_closed; });
+		if (m_closed) { return false; }
+		m_items.push_back(value);
+		lock.unlock();
+		m_not_empty.notify_one();
+		return true;
+	}
+
+	auto receive(std::span<std::uint64_t> out) -> std::size_t {
+		auto lock = std::unique_lock{m_mutex};
+		m_not_empty.wait(lock, [&] { return !m_items.empty() || m_closed; });
+		auto const ret = std::min(out.size(), m_items.size());
+		std::copy_n(m_items.begin(), ret, out.begin());
+		m_items.erase(m_items.begin(), m_items.begin() + std::ptrdiff_t(ret));
+		lock.unlock();
+		m_not_full.notify_all();
+		return ret;
+	}
+
+	void close() {
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			m_closed = true;
+		}
+		m_not_full.notify_all();
+		m_not_empty.notify_all();
+	}
+
+  private:
+	std::mutex m_mutex{};
+	std::condition_variable m_not_empty{};
+	std::condition_variable m_not_full{};
+	std::vector<std::uint64_t> m_items{};
+	std::size_t m_capacity;
+	bool m_closed{};
+};
+
+// batch_size 1 receives one element per call.
+template <typename ChannelT>
+auto run(std::size_t const producers, std::size_t const consumers, std::size_t const batch_size) -> klib::bench::Seconds {
+	return klib::bench::best_of(runs_v, [&] {
+		auto channel = ChannelT{capacity_v};
+		auto sums = std::vector<std::uint64_t>(consumers);
+		{
+			auto consumer_threads = std::vector<std::jthread>{};
+			for (auto c = std::size_t{}; c < consumers; ++c) {
+				consumer_threads.emplace_back([&, c] {
+					auto batch = std::array<std::uint64_t, batch_size_v>{};
+					auto const out = std::span{batch}.first(batch_size);
+					for (auto count = channel.receive(out); count > 0; count = channel.receive(out)) {
+						for (auto const value : out.first(count)) { sums[c] += value; }
+					}
+				});
+			}
+			{
+				auto producer_threads = std::vector<std::jthread>{};
+				for (auto p = std::size_t{}; p < producers; ++p) {
+					producer_threads.emplace_back([&] {
+						for (auto i = std::uint64_t{}; i < item_count_v / producers; ++i) { channel.send(i); }
+					});
+				}
+			}
+			channel.close();
+		}
+	});
+}
+
+template <typename ChannelT>
+void print_row(std::string_view const name, std::size_t const producers, std::size_t const consumers) {
+	std::print("{:<8} {}:{}", name, producers, consumers);
+	for (auto const batch_size : {std::size_t{1}, batch_size_v}) {
+		auto const elapsed = run<ChannelT>(producers, consumers, batch_size);
+		std::print(" | batch {:>2}: {:>12.0f} items/s", batch_size, klib::bench::per_second(item_count_v, elapsed));
+	}
+	std::println("");
+}
+} // namespace
+
+auto main() -> int {
+	using Spsc = klib::Channel<std::uint64_t, klib::ChannelMode::Spsc>;
+	using Mpmc = klib::Channel<std::uint64_t, klib::ChannelMode::Mpmc>;
+
+	klib::bench::print_header("single producer, single consumer");
+	print_row<LockedChannel>("locked", 1, 1);
+	print_row<Spsc>("spsc", 1, 1);
+	print_row<Mpmc>("mpmc", 1, 1);
+
+	auto const threads = std::max(std::size_t(std::thread::hardware_concurrency()) / 2, std::size_t{2});
+	klib::bench::print_header("multiple producers, multiple consumers");
+	print_row<LockedChannel>("locked", threads, threads);
+	print_row<Mpmc>("mpmc", threads, threads);
+}
@@ -0,0 +1,43 @@
+#include "alloc_counter.hpp"
+#include "bench.hpp"
+#include "klib/task/queue.hpp"
+#include <vector>
+
+namespace {
+using namespace klib::task;
+
+constexpr auto task_count_v = std::size_t{100'000};
+constexpr auto runs_v = std::size_t{3};
+
+struct TinyTask : Task {
+	void execute() final {}
+};
+
+[[nodiscard]] auto to_string(Scheduler const scheduler) -> std::string_view {
+	switch (scheduler) {
+	case Scheduler::WorkStealing: return "work_stealing";
+	default: return "shared";
+	}
+}
+
+// Steady state enqueue / execute: allocations per task and throughput, after a warm-up run.
+void run(Scheduler const scheduler) {
+	auto queue = Queue{QueueCreateInfo{.scheduler = scheduler}};
+	auto tasks = std::vector<TinyTask>(task_count_v);
+	auto const run_once = [&] {
+		for (auto& task : tasks) { queue.enqueue(task); }
+		queue.drain_and_wait();
+	};
+	run_once();
+	auto const allocations = klib::bench::allocation_count();
+	auto const elapsed = klib::bench::best_of(runs_v, run_once);
+	auto const per_task = double(klib::bench::allocation_count() - allocations) / double(task_count_v * runs_v);
+	std::println("{:<14} | allocs/task: {:>6.3f} | {:>12.0f} tasks/s", to_string(scheduler), per_task, klib::bench::per_second(task_count_v, elapsed));
+}
+} // namespace
+
+auto main() -> int {
+	klib::bench::print_header("enqueue allocations and throughput");
+	run(Scheduler::Shared);
+	run(Scheduler::WorkStealing);
+}
@@ -0,0 +1,38 @@
+#include "bench.hpp"
+#include "klib/task/queue.hpp"
+#include <array>
+#include <vector>
+
+namespace {
+using namespace klib::task;
+using klib::bench::Seconds;
+
+constexpr auto drain_count_v = std::size_t{2'000};
+
+struct NoopTask : Task {
+	void execute() final {}
+};
+
+// Frame-loop pattern: enqueue a handful of tasks, then drain.
+void run(std::size_t const tasks_per_drain) {
+	auto queue = Queue{QueueCreateInfo{}};
+	auto tasks = std::vector<NoopTask>(tasks_per_drain);
+	auto samples = std::vector<Seconds>{};
+	samples.reserve(drain_count_v);
+	for (auto i = std::size_t{}; i < drain_count_v; ++i) {
+		for (auto& task : tasks) { queue.enqueue(task); }
+		samples.push_back(klib::bench::measure([&queue] { queue.drain_and_wait(); }));
+	}
+	auto const p50 = klib::bench::percentile(std::span{samples}, 50.0);
+	auto const p99 = klib::bench::percentile(std::span{samples}, 99.0);
+	std::println("tasks: {:>4} | threads: {:>2} | p50: {:>8.1f}us | p99: {:>8.1f}us", tasks_per_drain, int(queue.thread_count()), p50.count() * 1e6,
+				 p99.count() * 1e6);
+}
+} // namespace
+
+auto main() -> int {
+	klib::bench::print_header("drain_and_wait cost");
+	run(0);
+	run(8);
+	run(64);
+}
@@ -0,0 +1,66 @@
+#include "bench.hpp"
+#include "klib/task/queue.hpp"
+#include <ctime>
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace klib::task;
+using namespace std::chrono_literals;
+using klib::bench::Clock;
+
+constexpr auto burst_count_v = std::size_t{500};
+constexpr auto burst_size_v = std::size_t{8};
+constexpr auto burst_interval_v = 50us;
+
+struct ProbeTask : Task {
+	Clock::time_point enqueued_at{};
+	klib::bench::Seconds latency{};
+
+	void execute() final { latency = Clock::now() - enqueued_at; }
+};
+
+[[nodiscard]] auto to_string(IdleMode const mode) -> std::string_view {
+	switch (mode) {
+	case IdleMode::Park: return "park";
+	default: return "adaptive";
+	}
+}
+
+// Enqueues periodic bursts of small tasks: measures enqueue-to-start latency and process CPU time (includes idle spinning).
+void run(IdlePolicy const& idle_policy) {
+	auto queue = Queue{QueueCreateInfo{.idle_policy = idle_policy}};
+	auto tasks = std::vector<ProbeTask>(burst_size_v);
+	auto latencies = std::vector<klib::bench::Seconds>{};
+	latencies.reserve(burst_count_v * burst_size_v);
+
+	auto const cpu_start = std::clock();
+	auto const wall = klib::bench::measure([&] {
+		for (auto i = std::size_t{}; i < burst_count_v; ++i) {
+			for (auto& task : tasks) {
+				task.enqueued_at = Clock::now();
+				queue.enqueue(task);
+			}
+			for (auto& task : tasks) {
+				task.wait();
+				latencies.push_back(task.latency);
+			}
+			std::this_thread::sleep_for(burst_interval_v);
+		}
+	});
+	auto const cpu = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+	auto const p50 = klib::bench::percentile(std::span{latencies}, 50.0);
+	auto const p99 = klib::bench::percentile(std::span{latencies}, 99.0);
+	std::println("idle: {:<8} | spin: {:>8} | yield: {:>8} | p50: {:>8.1f}us | p99: {:>8.1f}us | cpu/wall: {:>5.2f}", to_string(idle_policy.mode),
+				 idle_policy.spin_duration, idle_policy.yield_duration, p50.count() * 1e6, p99.count() * 1e6, cpu / wall.count());
+}
+} // namespace
+
+auto main() -> int {
+	klib::bench::print_header("enqueue-to-start latency and CPU burn per idle policy");
+	run(IdlePolicy{.mode = IdleMode::Park});
+	run(IdlePolicy{.mode = IdleMode::Adaptive, .spin_duration = 5us, .yield_duration = 20us});
+	run(IdlePolicy{.mode = IdleMode::Adaptive});
+	run(IdlePolicy{.mode = IdleMode::Adaptive, .spin_duration = 100us, .yield_duration = 500us});
+}
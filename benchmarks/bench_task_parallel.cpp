@@ -0,0 +1,65 @@
+#include "bench.hpp"
+#include "klib/task/parallel.hpp"
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#if defined(KLIB_BENCH_STD_PAR)
+#include <execution>
+#endif
+
+namespace {
+using namespace klib::task;
+
+constexpr auto element_count_v = std::size_t{10'000'000};
+constexpr auto runs_v = std::size_t{5};
+
+[[nodiscard]] auto heavy(float const value) -> float { return std::sqrt(value) * std::sin(value); }
+
+void print_row(std::string_view const name, klib::bench::Seconds const elapsed, klib::bench::Seconds const serial) {
+	std::println("{:<28} | {:>9.3f}ms | x{:.2f}", name, elapsed.count() * 1e3, serial / elapsed);
+}
+
+void bench_transform(Queue& queue, std::span<float const> input, std::span<float> output) {
+	klib::bench::print_header("transform: sqrt(x) * sin(x)");
+	auto const serial = klib::bench::best_of(runs_v, [&] { std::ranges::transform(input, output.begin(), heavy); });
+	print_row("serial", serial, serial);
+	for (auto const split : {Split::Static, Split::Adaptive}) {
+		auto const elapsed = klib::bench::best_of(runs_v, [&] { parallel_transform(queue, input, output, heavy, Partition{.split = split}); });
+		print_row(split == Split::Static ? "parallel_transform (static)" : "parallel_transform (adaptive)", elapsed, serial);
+	}
+#if defined(KLIB_BENCH_STD_PAR)
+	auto const std_par = klib::bench::best_of(runs_v, [&] { std::transform(std::execution::par, input.begin(), input.end(), output.begin(), heavy); });
+	print_row("std::execution::par", std_par, serial);
+#endif
+}
+
+void bench_reduce(Queue& queue, std::span<float const> input) {
+	klib::bench::print_header("reduce: sum");
+	auto sink = 0.0;
+	auto const plus = [](double const a, double const b) { return a + b; };
+	auto const serial = klib::bench::best_of(runs_v, [&] { sink += std::accumulate(input.begin(), input.end(), 0.0); });
+	print_row("serial", serial, serial);
+	auto const to_double = [input](std::size_t const i) { return double(input[i]); };
+	for (auto const split : {Split::Static, Split::Adaptive}) {
+		auto const elapsed =
+			klib::bench::best_of(runs_v, [&] { sink += parallel_reduce(queue, 0, input.size(), 0.0, to_double, plus, Partition{.split = split}); });
+		print_row(split == Split::Static ? "parallel_reduce (static)" : "parallel_reduce (adaptive)", elapsed, serial);
+	}
+#if defined(KLIB_BENCH_STD_PAR)
+	auto const std_par = klib::bench::best_of(runs_v, [&] { sink += std::reduce(std::execution::par, input.begin(), input.end(), 0.0); });
+	print_row("std::execution::par", std_par, serial);
+#endif
+	std::println("(sink: {})", sink);
+}
+} // namespace
+
+auto main() -> int {
+	auto queue = Queue{};
+	std::println("threads: {}", std::size_t(queue.thread_count()));
+	auto input = std::vector<float>(element_count_v);
+	std::iota(input.begin(), input.end(), 0.0f);
+	auto output = std::vector<float>(input.size());
+	bench_transform(queue, input, output);
+	bench_reduce(queue, input);
+}
@@ -0,0 +1,69 @@
+#include "bench.hpp"
+#include "klib/task/queue.hpp"
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace klib::task;
+using namespace std::chrono_literals;
+using klib::bench::Clock;
+
+constexpr auto bulk_duration_v = 20us;
+constexpr auto bulk_per_thread_v = std::size_t{8'000};
+constexpr auto probe_count_v = std::size_t{500};
+constexpr auto probe_interval_v = 200us;
+
+struct BulkTask : Task {
+	void execute() final {
+		auto const end = Clock::now() + bulk_duration_v;
+		while (Clock::now() < end) {}
+	}
+};
+
+struct ProbeTask : Task {
+	Clock::time_point enqueued_at{};
+	klib::bench::Seconds latency{};
+
+	void execute() final { latency = Clock::now() - enqueued_at; }
+};
+
+[[nodiscard]] auto to_string(Priority const priority) -> std::string_view {
+	switch (priority) {
+	case Priority::Low: return "low";
+	case Priority::High: return "high";
+	default: return "normal";
+	}
+}
+
+// Saturates the queue with Normal bulk tasks, then measures enqueue-to-start latency of periodic probes.
+void run(Priority const probe_priority, std::chrono::nanoseconds const lane_aging) {
+	auto queue = Queue{QueueCreateInfo{.lane_aging = lane_aging}};
+	auto bulk = std::vector<BulkTask>(bulk_per_thread_v * std::size_t(queue.thread_count()));
+	auto probes = std::vector<ProbeTask>(probe_count_v);
+
+	for (auto& task : bulk) { queue.enqueue(task); }
+	for (auto& probe : probes) {
+		probe.enqueued_at = Clock::now();
+		queue.enqueue(probe, probe_priority);
+		std::this_thread::sleep_for(probe_interval_v);
+	}
+	for (auto& probe : probes) { probe.wait(); }
+	queue.drop_enqueued();
+	for (auto& task : bulk) { task.wait(); }
+
+	auto latencies = std::vector<klib::bench::Seconds>{};
+	latencies.reserve(probes.size());
+	for (auto const& probe : probes) { latencies.push_back(probe.latency); }
+	auto const p50 = klib::bench::percentile(std::span{latencies}, 50.0);
+	auto const p99 = klib::bench::percentile(std::span{latencies}, 99.0);
+	std::println("probe: {:<6} | aging: {:>8} | p50: {:>10.1f}us | p99: {:>10.1f}us", to_string(probe_priority), lane_aging, p50.count() * 1e6,
+				 p99.count() * 1e6);
+}
+} // namespace
+
+auto main() -> int {
+	klib::bench::print_header("enqueue-to-start latency under saturation");
+	run(Priority::Normal, {});
+	run(Priority::High, {});
+	run(Priority::High, 1ms);
+}
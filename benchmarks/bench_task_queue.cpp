@@ -0,0 +1,83 @@
+#include "bench.hpp"
+#include "klib/task/queue.hpp"
+#include <atomic>
+#include <span>
+#include <vector>
+
+namespace {
+using namespace klib::task;
+
+constexpr auto task_count_v = std::size_t{100'000};
+constexpr auto fanout_v = std::size_t{16};
+constexpr auto runs_v = std::size_t{3};
+
+struct TinyTask : Task {
+	std::atomic<std::size_t>* counter{};
+
+	void execute() final {
+		auto volatile sink = std::size_t{};
+		for (auto i = std::size_t{}; i < 64; ++i) { sink = sink + i; }
+		counter->fetch_add(1, std::memory_order_relaxed);
+	}
+};
+
+struct SpawnTask : Task {
+	Queue* queue{};
+	std::span<TinyTask> children{};
+
+	void execute() final {
+		for (auto& child : children) { queue->enqueue(child); }
+	}
+};
+
+[[nodiscard]] auto to_string(Scheduler const scheduler) -> std::string_view {
+	switch (scheduler) {
+	case Scheduler::WorkStealing: return "work_stealing";
+	default: return "shared";
+	}
+}
+
+void wait_all(std::span<TinyTask> tasks) {
+	for (auto& task : tasks) { task.wait(); }
+}
+
+// All tasks enqueued from the calling thread.
+auto run_flat(Queue& queue, std::vector<TinyTask>& tasks) -> klib::bench::Seconds {
+	auto counter = std::atomic<std::size_t>{};
+	for (auto& task : tasks) { task.counter = &counter; }
+	return klib::bench::best_of(runs_v, [&] {
+		for (auto& task : tasks) { queue.enqueue(task); }
+		wait_all(tasks);
+	});
+}
+
+// Roots enqueued from the calling thread, each spawns its children from a worker.
+auto run_nested(Queue& queue, std::vector<TinyTask>& tasks) -> klib::bench::Seconds {
+	auto counter = std::atomic<std::size_t>{};
+	for (auto& task : tasks) { task.counter = &counter; }
+	auto roots = std::vector<SpawnTask>(tasks.size() / fanout_v);
+	for (auto i = std::size_t{}; i < roots.size(); ++i) {
+		roots[i].queue = &queue;
+		roots[i].children = std::span{tasks}.subspan(i * fanout_v, fanout_v);
+	}
+	return klib::bench::best_of(runs_v, [&] {
+		for (auto& root : roots) { queue.enqueue(root); }
+		for (auto& root : roots) { root.wait(); }
+		wait_all(tasks);
+	});
+}
+} // namespace
+
+auto main() -> int {
+	auto tasks = std::vector<TinyTask>(task_count_v);
+	for (auto const scheduler : {Scheduler::Shared, Scheduler::WorkStealing}) {
+		klib::bench::print_header(to_string(scheduler));
+		for (auto threads = 1; threads <= int(get_max_threads()); threads *= 2) {
+			auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount(threads), .scheduler = scheduler}};
+			auto const flat = run_flat(queue, tasks);
+			auto const nested = run_nested(queue, tasks);
+			std::println("threads: {:>3} | flat: {:>12.0f} tasks/s | nested: {:>12.0f} tasks/s", threads, klib::bench::per_second(tasks.size(), flat),
+						 klib::bench::per_second(tasks.size(), nested));
+		}
+	}
+}
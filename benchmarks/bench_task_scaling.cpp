@@ -0,0 +1,78 @@
+#include "bench.hpp"
+#include "klib/task/queue.hpp"
+#include <array>
+#include <atomic>
+#include <span>
+#include <vector>
+
+namespace {
+using namespace klib::task;
+
+constexpr auto task_count_v = std::size_t{200'000};
+constexpr auto fanout_v = std::size_t{32};
+constexpr auto runs_v = std::size_t{3};
+// 0: a single group of workers.
+constexpr auto group_sizes_v = std::array<std::size_t, 3>{0, 64, 16};
+
+struct TinyTask : Task {
+	void execute() final {
+		auto volatile sink = std::size_t{};
+		for (auto i = std::size_t{}; i < 64; ++i) { sink = sink + i; }
+	}
+};
+
+struct SpawnTask : Task {
+	Queue* queue{};
+	std::span<TinyTask> children{};
+
+	void execute() final {
+		for (auto& child : children) { queue->enqueue(child); }
+	}
+};
+
+[[nodiscard]] auto to_string(Scheduler const scheduler) -> std::string_view {
+	switch (scheduler) {
+	case Scheduler::WorkStealing: return "work_stealing";
+	default: return "shared";
+	}
+}
+
+// 1, 2, 4, ... up to and including the hardware thread count.
+[[nodiscard]] auto get_thread_counts() -> std::vector<std::size_t> {
+	auto const max_threads = std::size_t(get_max_threads());
+	auto ret = std::vector<std::size_t>{};
+	for (auto threads = std::size_t{1}; threads < max_threads; threads *= 2) { ret.push_back(threads); }
+	ret.push_back(max_threads);
+	return ret;
+}
+
+// Roots enqueued from the calling thread, each spawns its children from a worker: most enqueues come from workers.
+auto run_nested(Queue& queue, std::vector<TinyTask>& tasks) -> klib::bench::Seconds {
+	auto roots = std::vector<SpawnTask>(tasks.size() / fanout_v);
+	for (auto i = std::size_t{}; i < roots.size(); ++i) {
+		roots[i].queue = &queue;
+		roots[i].children = std::span{tasks}.subspan(i * fanout_v, fanout_v);
+	}
+	return klib::bench::best_of(runs_v, [&] {
+		for (auto& root : roots) { queue.enqueue(root); }
+		for (auto& root : roots) { root.wait(); }
+		for (auto& task : tasks) { task.wait(); }
+	});
+}
+} // namespace
+
+auto main() -> int {
+	auto tasks = std::vector<TinyTask>(task_count_v);
+	for (auto const scheduler : {Scheduler::Shared, Scheduler::WorkStealing}) {
+		klib::bench::print_header(to_string(scheduler));
+		for (auto const threads : get_thread_counts()) {
+			std::print("threads: {:>4}", threads);
+			for (auto const group_size : group_sizes_v) {
+				auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount(threads), .scheduler = scheduler, .worker_group_size = group_size}};
+				auto const elapsed = run_nested(queue, tasks);
+				std::print(" | group {:>2}: {:>12.0f} tasks/s", group_size, klib::bench::per_second(tasks.size(), elapsed));
+			}
+			std::println("");
+		}
+	}
+}
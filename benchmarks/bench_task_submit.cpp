@@ -0,0 +1,63 @@
+#include "alloc_counter.hpp"
+#include "bench.hpp"
+#include "klib/task/queue.hpp"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace {
+using namespace klib::task;
+
+constexpr auto task_count_v = std::size_t{100'000};
+constexpr auto runs_v = std::size_t{3};
+
+std::atomic<std::size_t> g_counter{}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+struct CountTask : Task {
+	void execute() final { g_counter.fetch_add(1, std::memory_order_relaxed); }
+};
+
+// Measures after a warm-up run: steady state throughput and allocations per task.
+template <typename F>
+void run(std::string_view const name, F func) {
+	func();
+	auto const allocations = klib::bench::allocation_count();
+	auto const elapsed = klib::bench::best_of(runs_v, func);
+	auto const per_task = double(klib::bench::allocation_count() - allocations) / double(task_count_v * runs_v);
+	std::println("{:<18} | allocs/task: {:>6.3f} | {:>12.0f} tasks/s", name, per_task, klib::bench::per_second(task_count_v, elapsed));
+}
+} // namespace
+
+auto main() -> int {
+	auto queue = Queue{};
+	klib::bench::print_header("submit vs hand-written Task");
+
+	auto tasks = std::vector<CountTask>(task_count_v);
+	run("task subclass", [&] {
+		for (auto& task : tasks) { queue.enqueue(task); }
+		queue.drain_and_wait();
+	});
+
+	run("new per job", [&] {
+		auto owned = std::vector<std::unique_ptr<CountTask>>{};
+		owned.reserve(task_count_v);
+		for (auto i = std::size_t{}; i < task_count_v; ++i) { queue.enqueue(*owned.emplace_back(std::make_unique<CountTask>())); }
+		queue.drain_and_wait();
+	});
+
+	run("submit", [&] {
+		for (auto i = std::size_t{}; i < task_count_v; ++i) {
+			queue.submit([] { g_counter.fetch_add(1, std::memory_order_relaxed); });
+		}
+		queue.drain_and_wait();
+	});
+
+	run("submit (large)", [&] {
+		auto const payload = std::array<std::size_t, 32>{};
+		for (auto i = std::size_t{}; i < task_count_v; ++i) {
+			queue.submit([payload] { g_counter.fetch_add(payload.size(), std::memory_order_relaxed); });
+		}
+		queue.drain_and_wait();
+	});
+}
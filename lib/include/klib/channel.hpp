@@ -0,0 +1,270 @@
+#pragma once
+#include "klib/task/notifier.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace klib {
+/// \brief Endpoints of a Channel.
+/// Spsc: at most one thread sends and one thread receives at any time. Wait-free, batch receives take all elements in one step.
+/// Mpmc: any number of threads send and receive. Lock-free.
+enum class ChannelMode : std::int8_t { Spsc, Mpmc };
+
+/// \brief Bounded FIFO hand-off between pipeline stages, capacity is rounded up to a power of two (at least 2).
+/// Non-blocking calls never lock, blocking ones only lock to sleep while the Channel is full / empty.
+/// Once closed, sends fail and receives return what is left (then nothing). A send racing close() may still succeed.
+template <std::move_constructible Type, ChannelMode Mode = ChannelMode::Mpmc>
+class Channel {
+  public:
+	using value_type = Type;
+
+	static constexpr auto mode_v = Mode;
+
+	Channel(Channel const&) = delete;
+	Channel(Channel&&) = delete;
+	auto operator=(Channel const&) -> Channel& = delete;
+	auto operator=(Channel&&) -> Channel& = delete;
+
+	explicit Channel(std::size_t const capacity = 64) : m_slots(std::bit_ceil(std::max(capacity, min_capacity_v))), m_mask(m_slots.size() - 1) {
+		for (auto i = std::size_t{}; i < m_slots.size(); ++i) { m_slots[i].sequence.store(i, std::memory_order_relaxed); }
+	}
+
+	~Channel() = default;
+
+	[[nodiscard]] auto capacity() const -> std::size_t { return m_slots.size(); }
+	/// \brief Approximate while other threads are sending / receiving.
+	[[nodiscard]] auto size() const -> std::size_t {
+		auto const head = m_head.load(std::memory_order_acquire);
+		auto const tail = m_tail.load(std::memory_order_acquire);
+		return tail > head ? std::min(tail - head, capacity()) : 0;
+	}
+	[[nodiscard]] auto is_empty() const -> bool { return size() == 0; }
+	[[nodiscard]] auto is_closed() const -> bool { return m_closed; }
+
+	/// \brief Fails if the Channel is full or closed: value is left untouched.
+	auto try_send(Type const& value) -> bool { return try_send_impl(value); }
+	auto try_send(Type&& value) -> bool { return try_send_impl(std::move(value)); }
+	/// \brief Block while the Channel is full. Fails if it is closed.
+	auto send(Type const& value) -> bool { return send_impl(value); }
+	auto send(Type&& value) -> bool { return send_impl(std::move(value)); }
+
+	[[nodiscard]] auto try_receive() -> std::optional<Type> {
+		auto ret = pop();
+		if (ret) { on_received(1); }
+		return ret;
+	}
+
+	/// \brief Block while the Channel is empty: returns nothing once it is closed and empty.
+	[[nodiscard]] auto receive() -> std::optional<Type> {
+		if (auto ret = pop()) {
+			on_received(1);
+			return ret;
+		}
+		auto ret = std::optional<Type>{};
+		wait_for(m_waiting_receivers, m_not_empty, [&] {
+			ret = pop();
+			return ret.has_value();
+		});
+		if (ret) { on_received(1); }
+		return ret;
+	}
+
+	/// \brief Move up to out.size() elements into out, synchronizing once for the whole batch.
+	/// \returns Number of elements received.
+	auto try_receive(std::span<Type> out) -> std::size_t {
+		auto const ret = pop(out);
+		if (ret > 0) { on_received(ret); }
+		return ret;
+	}
+
+	/// \brief Block until at least one element is received: returns 0 once the Channel is closed and empty.
+	auto receive(std::span<Type> out) -> std::size_t {
+		if (out.empty()) { return 0; }
+		auto ret = pop(out);
+		if (ret == 0) {
+			wait_for(m_waiting_receivers, m_not_empty, [&] {
+				ret = pop(out);
+				return ret > 0;
+			});
+		}
+		if (ret > 0) { on_received(ret); }
+		return ret;
+	}
+
+	/// \brief Wake all blocked senders and receivers: subsequent sends fail.
+	void close() {
+		m_closed = true;
+		{ auto lock = std::scoped_lock{m_mutex}; }
+		m_not_full.notify_all();
+		m_not_empty.notify_all();
+	}
+
+	/// \brief Notify notifier after every successful send, eg to run a Task that drains the Channel on a Queue.
+	/// Must be set before sending starts, and outlive the Channel (or be reset).
+	/// If the Notifier's Queue rejects its Task (full / draining), the Task runs inline: inside send(), on the sending thread.
+	void set_notifier(task::Notifier* notifier) { m_notifier = notifier; }
+
+  private:
+	static constexpr auto cache_line_v = std::size_t{64};
+	// a single Mpmc slot cannot tell full from empty: its sequence after a send equals the next send position.
+	static constexpr auto min_capacity_v = std::size_t{2};
+
+	// sequence is only used in Mpmc mode.
+	struct Slot {
+		std::atomic<std::size_t> sequence{};
+		std::optional<Type> value{};
+	};
+
+	template <typename U>
+	auto try_send_impl(U&& value) -> bool {
+		if (!push(std::forward<U>(value))) { return false; }
+		on_sent(1);
+		return true;
+	}
+
+	template <typename U>
+	auto send_impl(U&& value) -> bool {
+		auto sent = push(std::forward<U>(value));
+		if (!sent) {
+			wait_for(m_waiting_senders, m_not_full, [&] {
+				sent = push(std::forward<U>(value));
+				return sent;
+			});
+		}
+		if (sent) { on_sent(1); }
+		return sent;
+	}
+
+	// waiters register with an RMW before evaluating ready(), wake() reads the count with an RMW after publishing an update:
+	// either the waiter observes the update, or wake() observes the waiter (and notifies under the lock).
+	template <typename F>
+	void wait_for(std::atomic<std::size_t>& waiting, std::condition_variable& cv, F ready) {
+		auto lock = std::unique_lock{m_mutex};
+		waiting.fetch_add(1, std::memory_order_acq_rel);
+		cv.wait(lock, [&] { return ready() || m_closed; });
+		waiting.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	void wake(std::atomic<std::size_t>& waiting, std::condition_variable& cv, std::size_t const count) {
+		if (waiting.fetch_add(0, std::memory_order_acq_rel) == 0) { return; }
+		{ auto lock = std::scoped_lock{m_mutex}; }
+		if (count > 1) {
+			cv.notify_all();
+		} else {
+			cv.notify_one();
+		}
+	}
+
+	void on_sent(std::size_t const count) {
+		wake(m_waiting_receivers, m_not_empty, count);
+		if (m_notifier != nullptr) { m_notifier->notify(); }
+	}
+
+	void on_received(std::size_t const count) { wake(m_waiting_senders, m_not_full, count); }
+
+	// value is only moved from once a slot has been claimed.
+	template <typename U>
+	auto push(U&& value) -> bool {
+		if (m_closed.load(std::memory_order_relaxed)) { return false; }
+		if constexpr (Mode == ChannelMode::Spsc) {
+			auto const tail = m_tail.load(std::memory_order_relaxed);
+			if (tail - m_head.load(std::memory_order_acquire) > m_mask) { return false; }
+			m_slots[tail & m_mask].value.emplace(std::forward<U>(value));
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		} else {
+			auto position = m_tail.load(std::memory_order_relaxed);
+			while (true) {
+				auto& slot = m_slots[position & m_mask];
+				auto const diff = std::intptr_t(slot.sequence.load(std::memory_order_acquire)) - std::intptr_t(position);
+				if (diff == 0) {
+					if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						slot.value.emplace(std::forward<U>(value));
+						slot.sequence.store(position + 1, std::memory_order_release);
+						return true;
+					}
+				} else if (diff < 0) {
+					return false;
+				} else {
+					position = m_tail.load(std::memory_order_relaxed);
+				}
+			}
+		}
+	}
+
+	[[nodiscard]] auto pop() -> std::optional<Type> {
+		if constexpr (Mode == ChannelMode::Spsc) {
+			auto const head = m_head.load(std::memory_order_relaxed);
+			if (m_tail.load(std::memory_order_acquire) == head) { return {}; }
+			auto ret = take(m_slots[head & m_mask]);
+			m_head.store(head + 1, std::memory_order_release);
+			return ret;
+		} else {
+			auto position = m_head.load(std::memory_order_relaxed);
+			while (true) {
+				auto& slot = m_slots[position & m_mask];
+				auto const diff = std::intptr_t(slot.sequence.load(std::memory_order_acquire)) - std::intptr_t(position + 1);
+				if (diff == 0) {
+					if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						auto ret = take(slot);
+						slot.sequence.store(position + m_mask + 1, std::memory_order_release);
+						return ret;
+					}
+				} else if (diff < 0) {
+					return {};
+				} else {
+					position = m_head.load(std::memory_order_relaxed);
+				}
+			}
+		}
+	}
+
+	// Spsc publishes the whole batch with a single store.
+	[[nodiscard]] auto pop(std::span<Type> out) -> std::size_t {
+		if constexpr (Mode == ChannelMode::Spsc) {
+			auto const head = m_head.load(std::memory_order_relaxed);
+			auto const count = std::min(m_tail.load(std::memory_order_acquire) - head, out.size());
+			for (auto i = std::size_t{}; i < count; ++i) { out[i] = *take(m_slots[(head + i) & m_mask]); }
+			if (count > 0) { m_head.store(head + count, std::memory_order_release); }
+			return count;
+		} else {
+			auto ret = std::size_t{};
+			while (ret < out.size()) {
+				auto value = pop();
+				if (!value) { break; }
+				out[ret++] = std::move(*value);
+			}
+			return ret;
+		}
+	}
+
+	[[nodiscard]] static auto take(Slot& slot) -> std::optional<Type> {
+		auto ret = std::move(slot.value);
+		slot.value.reset();
+		return ret;
+	}
+
+	std::vector<Slot> m_slots;
+	std::size_t m_mask;
+	alignas(cache_line_v) std::atomic<std::size_t> m_tail{};
+	alignas(cache_line_v) std::atomic<std::size_t> m_head{};
+	alignas(cache_line_v) std::atomic<bool> m_closed{};
+
+	std::mutex m_mutex{};
+	std::condition_variable m_not_empty{};
+	std::condition_variable m_not_full{};
+	alignas(cache_line_v) std::atomic<std::size_t> m_waiting_senders{};
+	alignas(cache_line_v) std::atomic<std::size_t> m_waiting_receivers{};
+
+	task::Notifier* m_notifier{};
+};
+} // namespace klib
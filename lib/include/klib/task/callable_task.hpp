@@ -0,0 +1,56 @@
+#pragma once
+#include "klib/task/task.hpp"
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace klib::task::detail {
+/// \brief Task that owns a type-erased callable: stored inline if it fits, on the heap otherwise.
+class CallableTask : public Task {
+  public:
+	static constexpr auto inline_size_v = std::size_t{64};
+
+	template <typename Type>
+	static constexpr auto fits_inline_v =
+		sizeof(Type) <= inline_size_v && alignof(Type) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Type>;
+
+	CallableTask() = default;
+	CallableTask(CallableTask const&) = delete;
+	CallableTask(CallableTask&&) = delete;
+	auto operator=(CallableTask const&) -> CallableTask& = delete;
+	auto operator=(CallableTask&&) -> CallableTask& = delete;
+
+	~CallableTask() override { reset(); }
+
+	template <typename FuncT>
+	void emplace(FuncT&& func) {
+		using Type = std::decay_t<FuncT>;
+		reset();
+		if constexpr (fits_inline_v<Type>) {
+			m_callable = new (m_storage.data()) Type(std::forward<FuncT>(func));
+			m_destroy = [](void* ptr) { static_cast<Type*>(ptr)->~Type(); };
+		} else {
+			m_callable = new Type(std::forward<FuncT>(func)); // NOLINT(cppcoreguidelines-owning-memory)
+			m_destroy = [](void* ptr) { delete static_cast<Type*>(ptr); }; // NOLINT(cppcoreguidelines-owning-memory)
+		}
+		m_invoke = [](void* ptr) { std::invoke(*static_cast<Type*>(ptr)); };
+	}
+
+	void reset() {
+		if (m_callable == nullptr) { return; }
+		m_destroy(m_callable);
+		m_callable = nullptr;
+	}
+
+  private:
+	void execute() final { m_invoke(m_callable); }
+
+	alignas(std::max_align_t) std::array<std::byte, inline_size_v> m_storage{};
+	void* m_callable{};
+	void (*m_invoke)(void*){};
+	void (*m_destroy)(void*){};
+};
+} // namespace klib::task::detail
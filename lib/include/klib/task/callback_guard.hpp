@@ -0,0 +1,21 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+namespace klib::task::detail {
+// Keeps an object alive while callbacks are still inside it, after its owner has observed the state they published (eg a counter reaching zero).
+// leave() must be a callback's last access to the object: nothing notifies after it, so wait_idle() yields until every callback has left.
+class CallbackGuard {
+  public:
+	void enter() { m_count.fetch_add(1); }
+	void leave() { m_count.fetch_sub(1); }
+
+	void wait_idle() const {
+		while (m_count.load() > 0) { std::this_thread::yield(); }
+	}
+
+  private:
+	std::atomic<std::size_t> m_count{};
+};
+} // namespace klib::task::detail
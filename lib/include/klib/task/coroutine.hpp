@@ -0,0 +1,245 @@
+#pragma once
+#include "klib/task/callback_guard.hpp"
+#include "klib/task/queue.hpp"
+#include "klib/task/schedule.hpp"
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace klib::task {
+template <typename Type = void>
+class Coroutine;
+
+namespace detail {
+// completion point shared by a group of coroutines: the last one to arrive resumes the parent, or wakes wait().
+class Join {
+  public:
+	void reset(std::size_t const count, std::coroutine_handle<> const parent = {}) {
+		m_parent = parent;
+		m_remaining = count;
+	}
+
+	[[nodiscard]] auto arrive() -> bool { return m_remaining.fetch_sub(1) == 1; }
+
+	[[nodiscard]] auto on_complete() -> std::coroutine_handle<> {
+		// copy parent first: the last arrival may release the owner of this Join.
+		auto const parent = m_parent;
+		if (parent) { return arrive() ? parent : std::noop_coroutine(); }
+		// wait() may return as soon as m_remaining reaches zero: the owner is kept alive until notify_all() has returned.
+		m_in_callback.enter();
+		if (arrive()) { m_remaining.notify_all(); }
+		m_in_callback.leave();
+		return std::noop_coroutine();
+	}
+
+	void wait() {
+		for (auto remaining = m_remaining.load(); remaining > 0; remaining = m_remaining.load()) { m_remaining.wait(remaining); }
+		m_in_callback.wait_idle();
+	}
+
+  private:
+	std::atomic<std::size_t> m_remaining{};
+	std::coroutine_handle<> m_parent{};
+	CallbackGuard m_in_callback{};
+};
+
+class PromiseBase {
+  public:
+	struct FinalAwaiter {
+		[[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+		template <std::derived_from<PromiseBase> PromiseT>
+		auto await_suspend(std::coroutine_handle<PromiseT> const handle) const noexcept -> std::coroutine_handle<> {
+			auto& promise = handle.promise();
+			if (promise.join != nullptr) { return promise.join->on_complete(); }
+			if (promise.continuation) { return promise.continuation; }
+			return std::noop_coroutine();
+		}
+
+		void await_resume() const noexcept {}
+	};
+
+	[[nodiscard]] auto initial_suspend() const noexcept -> std::suspend_always { return {}; }
+	[[nodiscard]] auto final_suspend() const noexcept -> FinalAwaiter { return {}; }
+
+	void unhandled_exception() { m_exception = std::current_exception(); }
+
+	void rethrow_if_failed() const {
+		if (m_exception) { std::rethrow_exception(m_exception); }
+	}
+
+	std::coroutine_handle<> continuation{};
+	Join* join{};
+	Schedule start{};
+
+  private:
+	std::exception_ptr m_exception{};
+};
+
+template <typename Type>
+class Promise : public PromiseBase {
+  public:
+	auto get_return_object() -> Coroutine<Type>;
+
+	template <std::convertible_to<Type> T>
+	void return_value(T&& value) {
+		m_value.emplace(std::forward<T>(value));
+	}
+
+	[[nodiscard]] auto get() -> Type& {
+		rethrow_if_failed();
+		return *m_value;
+	}
+
+  private:
+	std::optional<Type> m_value{};
+};
+
+template <>
+class Promise<void> : public PromiseBase {
+  public:
+	auto get_return_object() -> Coroutine<void>;
+
+	void return_void() {}
+
+	void get() const { rethrow_if_failed(); }
+};
+} // namespace detail
+
+/// \brief Lazily started coroutine: runs when awaited, passed to when_all(), or sync_wait().
+/// co_await Queue::schedule() within it to hop onto a worker thread.
+template <typename Type>
+class Coroutine {
+  public:
+	using promise_type = detail::Promise<Type>;
+	using Handle = std::coroutine_handle<promise_type>;
+
+	Coroutine() = default;
+
+	explicit Coroutine(Handle const handle) : m_handle(handle) {}
+
+	Coroutine(Coroutine&& rhs) noexcept : m_handle(std::exchange(rhs.m_handle, {})) {}
+
+	auto operator=(Coroutine&& rhs) noexcept -> Coroutine& {
+		if (&rhs != this) { std::swap(m_handle, rhs.m_handle); }
+		return *this;
+	}
+
+	Coroutine(Coroutine const&) = delete;
+	auto operator=(Coroutine const&) -> Coroutine& = delete;
+
+	~Coroutine() {
+		if (m_handle) { m_handle.destroy(); }
+	}
+
+	[[nodiscard]] auto is_valid() const -> bool { return bool(m_handle); }
+	[[nodiscard]] auto is_done() const -> bool { return m_handle && m_handle.done(); }
+
+	/// \brief Result of a completed coroutine: rethrows any exception it exited with.
+	[[nodiscard]] auto get() -> decltype(auto) {
+		assert(is_valid());
+		return m_handle.promise().get();
+	}
+
+	[[nodiscard]] auto get_handle() const -> Handle { return m_handle; }
+
+	/// \brief Must be valid: an empty / moved-from Coroutine has no result to await.
+	auto operator co_await() noexcept {
+		assert(is_valid());
+		struct Awaiter {
+			[[nodiscard]] auto await_ready() const noexcept -> bool { return handle.done(); }
+
+			auto await_suspend(std::coroutine_handle<> const parent) const noexcept -> std::coroutine_handle<> {
+				handle.promise().continuation = parent;
+				return handle;
+			}
+
+			auto await_resume() const -> Type {
+				if constexpr (std::is_void_v<Type>) {
+					handle.promise().get();
+				} else {
+					return std::move(handle.promise().get());
+				}
+			}
+
+			Handle handle;
+		};
+		return Awaiter{m_handle};
+	}
+
+  private:
+	Handle m_handle{};
+};
+
+template <typename Type>
+auto detail::Promise<Type>::get_return_object() -> Coroutine<Type> {
+	return Coroutine<Type>{std::coroutine_handle<Promise>::from_promise(*this)};
+}
+
+inline auto detail::Promise<void>::get_return_object() -> Coroutine<void> {
+	return Coroutine<void>{std::coroutine_handle<Promise>::from_promise(*this)};
+}
+
+/// \brief Awaitable that starts every child on queue's workers and resumes the awaiting coroutine once all have completed.
+/// Results are read through each child's get().
+template <typename Type>
+class WhenAll {
+  public:
+	explicit WhenAll(Queue& queue, std::span<Coroutine<Type>> children) : m_queue(&queue), m_children(children) {}
+
+	[[nodiscard]] auto await_ready() const -> bool { return m_children.empty(); }
+
+	auto await_suspend(std::coroutine_handle<> const parent) -> bool {
+		// the extra count is released below: parent cannot be resumed before it has suspended.
+		m_join.reset(m_children.size() + 1, parent);
+		for (auto& child : m_children) {
+			auto const handle = child.get_handle();
+			auto& promise = handle.promise();
+			promise.join = &m_join;
+			if (!promise.start.resume_on(*m_queue, handle)) { handle.resume(); }
+		}
+		return !m_join.arrive();
+	}
+
+	void await_resume() const {
+		for (auto const& child : m_children) { child.get_handle().promise().rethrow_if_failed(); }
+	}
+
+  private:
+	Queue* m_queue;
+	std::span<Coroutine<Type>> m_children;
+	detail::Join m_join{};
+};
+
+template <typename Type>
+[[nodiscard]] auto when_all(Queue& queue, std::span<Coroutine<Type>> children) -> WhenAll<Type> {
+	return WhenAll<Type>{queue, children};
+}
+
+/// \brief Starts coroutine on the calling thread and blocks until it completes.
+template <typename Type>
+auto sync_wait(Coroutine<Type>& coroutine) -> Type {
+	auto join = detail::Join{};
+	join.reset(1);
+	auto const handle = coroutine.get_handle();
+	handle.promise().join = &join;
+	handle.resume();
+	join.wait();
+	if constexpr (std::is_void_v<Type>) {
+		coroutine.get();
+	} else {
+		return std::move(coroutine.get());
+	}
+}
+
+template <typename Type>
+auto sync_wait(Coroutine<Type>&& coroutine) -> Type {
+	return sync_wait(coroutine);
+}
+} // namespace klib::task
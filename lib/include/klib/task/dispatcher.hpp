@@ -0,0 +1,57 @@
+#pragma once
+#include "klib/task/callable_task.hpp"
+#include "klib/task/task.hpp"
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+namespace klib::task {
+/// \brief Limits of a single Dispatcher::pump(), zero is unlimited.
+/// The duration is checked after each Task: a pump runs at least one Task (if any are pending), and may overrun by the last one.
+struct PumpBudget {
+	std::size_t max_tasks{};
+	std::chrono::nanoseconds max_duration{};
+};
+
+/// \brief Runs Tasks on a single owner thread (render / IO owner / main thread).
+/// Any thread can enqueue without locking, the owner calls pump() (eg once per frame) to run pending Tasks in FIFO order.
+/// Tasks still pending on destruction are dropped.
+class Dispatcher {
+  public:
+	explicit Dispatcher(std::thread::id owner = std::this_thread::get_id());
+
+	[[nodiscard]] auto get_owner() const -> std::thread::id;
+	[[nodiscard]] auto is_owner_thread() const -> bool { return std::this_thread::get_id() == get_owner(); }
+	[[nodiscard]] auto pending_count() const -> std::size_t;
+
+	/// \brief Fails if task is busy (queued / executing elsewhere), or the Dispatcher has been moved from.
+	auto enqueue(Task& task) -> bool;
+
+	/// \brief Enqueue a callable in a pooled Task owned by the Dispatcher, see Queue::submit().
+	template <std::invocable FuncT>
+	auto submit(FuncT&& func) -> bool {
+		auto* task = acquire_callable();
+		if (task == nullptr) { return false; }
+		task->emplace(std::forward<FuncT>(func));
+		return enqueue(*task);
+	}
+
+	/// \brief Run pending Tasks until none are left or budget is exhausted: must be called on the owner thread.
+	/// Tasks enqueued while pumping run in the next call.
+	/// \returns Number of Tasks run.
+	auto pump(PumpBudget const& budget = {}) -> std::size_t;
+	/// \brief Drop all pending Tasks: must be called on the owner thread.
+	void drop_enqueued();
+
+  private:
+	auto acquire_callable() -> detail::CallableTask*;
+
+	struct Impl;
+	struct Deleter {
+		void operator()(Impl* ptr) const noexcept;
+	};
+	std::unique_ptr<Impl, Deleter> m_impl{};
+};
+} // namespace klib::task
@@ -0,0 +1,66 @@
+#pragma once
+#include "klib/task/callback_guard.hpp"
+#include "klib/task/queue_fwd.hpp"
+#include "klib/task/task.hpp"
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace klib::task {
+/// \brief DAG of Tasks: each Task is enqueued as soon as all its predecessors have completed.
+/// If a Task is dropped, all its (transitive) dependents are dropped too.
+/// A Task the Queue rejects (full / draining) runs inline on the thread that completed its last predecessor.
+class Graph {
+  public:
+	using Status = task::Status;
+
+	Graph() = default;
+	Graph(Graph const&) = delete;
+	Graph(Graph&&) = delete;
+	auto operator=(Graph const&) -> Graph& = delete;
+	auto operator=(Graph&&) -> Graph& = delete;
+
+	~Graph();
+
+	auto add(Task& task) -> Graph&;
+	auto add_edge(Task& from, Task& to) -> Graph&;
+	void clear();
+
+	[[nodiscard]] auto node_count() const -> std::size_t { return m_nodes.size(); }
+	[[nodiscard]] auto is_busy() const -> bool { return m_remaining > 0; }
+	[[nodiscard]] auto get_status() const -> Status;
+
+	/// \brief Enqueues all root Tasks. Fails if the Graph is busy, has a cycle, or contains a busy Task (or one added to a Group).
+	auto submit(Queue& queue) -> bool;
+	void wait();
+
+  private:
+	struct Node : Task::Observer {
+		explicit Node(Graph& graph, Task& task) : graph(&graph), task(&task) {}
+
+		void on_finalized(Status status) final;
+
+		Graph* graph;
+		Task* task;
+		std::vector<Node*> successors{};
+		std::size_t predecessors{};
+		std::atomic<std::size_t> pending{};
+		std::atomic<bool> dropped{};
+	};
+
+	auto get_or_add(Task& task) -> Node&;
+	[[nodiscard]] auto has_cycle() const -> bool;
+	void on_finalized(Node& node, Status status);
+	void finalize(Node& node, Status status, std::vector<Node*>& unqueued);
+
+	std::deque<Node> m_nodes{};
+	std::unordered_map<Task const*, Node*> m_lookup{};
+	Queue* m_queue{};
+	std::atomic<std::size_t> m_remaining{};
+	std::atomic<bool> m_dropped{};
+	detail::CallbackGuard m_in_callback{};
+	bool m_submitted{};
+};
+} // namespace klib::task
@@ -0,0 +1,66 @@
+#pragma once
+#include "klib/task/callback_guard.hpp"
+#include "klib/task/queue_fwd.hpp"
+#include "klib/task/task.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <span>
+
+namespace klib::task {
+/// \brief Tracks completion of a set of Tasks on a single counter: waiters are woken once, when the last one finishes.
+/// Tasks can be added while others are running. A Task must not be destroyed or added to another Group / Graph until it is done.
+class Group {
+  public:
+	Group() = default;
+	Group(Group const&) = delete;
+	Group(Group&&) = delete;
+	auto operator=(Group const&) -> Group& = delete;
+	auto operator=(Group&&) -> Group& = delete;
+
+	~Group();
+
+	/// \brief Track task: it must then be enqueued (or fork_joined) exactly once.
+	/// Fails if task is busy, or already observed (by another Group, a Graph, a Notifier, or as a pooled callable).
+	auto add(Task& task) -> bool;
+	/// \brief Add and enqueue tasks: nothing is added if any of them cannot be added, or the Queue rejects them.
+	auto enqueue(Queue& queue, Task& task) -> bool;
+	auto enqueue(Queue& queue, std::span<Task* const> tasks) -> bool;
+
+	[[nodiscard]] auto pending_count() const -> std::size_t { return m_pending; }
+	[[nodiscard]] auto dropped_count() const -> std::size_t { return m_dropped; }
+	[[nodiscard]] auto is_done() const -> bool { return m_pending == 0; }
+
+	void wait();
+	/// \returns false on timeout.
+	auto wait_for(std::chrono::nanoseconds timeout) -> bool;
+	/// \brief Wait for the next Task to finish: each finished Task satisfies exactly one call.
+	/// \returns false if no Task has finished and none are pending.
+	auto wait_any() -> bool;
+
+  private:
+	struct Tracker : Task::Observer {
+		explicit Tracker(Group& group) : group(&group) {}
+
+		void on_finalized(Status status) final;
+
+		Group* group;
+	};
+
+	void remove(std::span<Task* const> tasks);
+	void on_finalized(Status status);
+	void notify();
+
+	Tracker m_tracker{*this};
+	std::atomic<std::size_t> m_pending{};
+	std::atomic<std::size_t> m_finished{};
+	std::atomic<std::size_t> m_dropped{};
+	std::atomic<std::size_t> m_any_waiters{};
+	detail::CallbackGuard m_in_callback{};
+	std::size_t m_consumed{}; // guarded by m_mutex.
+	std::mutex m_mutex{};
+	std::condition_variable m_cv{};
+};
+} // namespace klib::task
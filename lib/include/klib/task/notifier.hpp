@@ -0,0 +1,50 @@
+#pragma once
+#include "klib/task/callback_guard.hpp"
+#include "klib/task/queue_fwd.hpp"
+#include "klib/task/task.hpp"
+#include <atomic>
+#include <cstddef>
+
+namespace klib::task {
+/// \brief Enqueues a Task on a Queue when notified: notifications are coalesced, at most one run is pending at a time.
+/// None are lost: notifications that arrive once a run has been scheduled trigger another run after it finishes.
+/// If the Queue rejects the Task (full / draining), it runs inline on the notifying thread.
+/// The Task must not be enqueued by other means while the Notifier is alive.
+class Notifier {
+  public:
+	Notifier(Notifier const&) = delete;
+	Notifier(Notifier&&) = delete;
+	auto operator=(Notifier const&) -> Notifier& = delete;
+	auto operator=(Notifier&&) -> Notifier& = delete;
+
+	explicit Notifier(Queue& queue, Task& task) : m_queue(&queue), m_task(&task) {}
+
+	~Notifier();
+
+	void notify();
+
+	[[nodiscard]] auto is_idle() const -> bool { return m_pending == 0; }
+	void wait();
+
+  private:
+	struct Tracker : Task::Observer {
+		explicit Tracker(Notifier& notifier) : notifier(&notifier) {}
+
+		void on_finalized(Status status) final;
+
+		Notifier* notifier;
+	};
+
+	void schedule();
+	void on_run_end();
+	[[nodiscard]] auto release_claim() -> bool;
+
+	Queue* m_queue;
+	Task* m_task;
+	Tracker m_tracker{*this};
+	std::atomic<std::size_t> m_pending{};
+	// notifications handled by the current run.
+	std::size_t m_claimed{};
+	detail::CallbackGuard m_in_callback{};
+};
+} // namespace klib::task
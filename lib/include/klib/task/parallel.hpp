@@ -0,0 +1,162 @@
+#pragma once
+#include "klib/task/queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace klib::task {
+/// \brief Static: fixed chunks of grain size.
+/// Adaptive: guided self-scheduling, chunks shrink with the remaining work (never below grain size).
+enum class Split : std::int8_t { Static, Adaptive };
+
+struct Partition {
+	/// \brief Minimum elements per chunk. 0: derived from the range size and thread count.
+	std::size_t grain_size{};
+	Split split{Split::Static};
+};
+
+namespace detail {
+class ChunkCursor {
+  public:
+	struct Chunk {
+		std::size_t begin{};
+		std::size_t end{};
+	};
+
+	explicit ChunkCursor(std::size_t const begin, std::size_t const end, std::size_t const grain_size, Split const split, std::size_t const runners)
+		: m_next(begin), m_end(end), m_grain_size(grain_size), m_divisor(split == Split::Adaptive ? 2 * runners : 0) {}
+
+	[[nodiscard]] auto next() -> std::optional<Chunk> {
+		if (m_divisor == 0) {
+			auto const begin = m_next.fetch_add(m_grain_size, std::memory_order_relaxed);
+			if (begin >= m_end) { return {}; }
+			return Chunk{.begin = begin, .end = std::min(begin + m_grain_size, m_end)};
+		}
+		auto begin = m_next.load(std::memory_order_relaxed);
+		while (begin < m_end) {
+			auto const size = std::max((m_end - begin) / m_divisor, m_grain_size);
+			auto const end = std::min(begin + size, m_end);
+			if (m_next.compare_exchange_weak(begin, end, std::memory_order_relaxed)) { return Chunk{.begin = begin, .end = end}; }
+		}
+		return {};
+	}
+
+  private:
+	std::atomic<std::size_t> m_next;
+	std::size_t m_end;
+	std::size_t m_grain_size;
+	std::size_t m_divisor;
+};
+
+// FuncT: void(std::size_t runner, std::size_t begin, std::size_t end).
+template <typename FuncT>
+class ChunkTask : public Task {
+  public:
+	ChunkCursor* cursor{};
+	FuncT* func{};
+	std::size_t runner{};
+
+  private:
+	void execute() final {
+		while (auto const chunk = cursor->next()) { (*func)(runner, chunk->begin, chunk->end); }
+	}
+};
+
+struct Plan {
+	std::size_t runner_count{};
+	std::size_t grain_size{};
+	Split split{};
+};
+
+[[nodiscard]] inline auto make_plan(Queue const& queue, std::size_t const count, Partition const& partition) -> Plan {
+	constexpr auto chunks_per_thread_v = std::size_t{4};
+	auto const threads = std::size_t(queue.thread_count()) + 1; // caller participates in fork_join.
+	auto const grain_size = partition.grain_size > 0 ? partition.grain_size : std::max(count / (threads * chunks_per_thread_v), std::size_t{1});
+	auto const chunk_count = (count + grain_size - 1) / grain_size;
+	return Plan{.runner_count = std::min(chunk_count, threads), .grain_size = grain_size, .split = partition.split};
+}
+
+// Runs func over [begin, end) in chunks on plan.runner_count Tasks; two allocations per call (the Tasks and their pointers), none per element.
+// If the Queue rejects the batch (draining), or drops some of it, the chunks left unclaimed run inline on the calling thread.
+template <typename FuncT>
+void run_chunks(Queue& queue, std::size_t const begin, std::size_t const end, Plan const& plan, FuncT& func) {
+	if (plan.runner_count <= 1) {
+		func(std::size_t{}, begin, end);
+		return;
+	}
+	auto cursor = ChunkCursor{begin, end, plan.grain_size, plan.split, plan.runner_count};
+	auto runners = std::make_unique<ChunkTask<FuncT>[]>(plan.runner_count);
+	auto to_join = std::vector<Task*>(plan.runner_count);
+	for (auto i = std::size_t{}; i < plan.runner_count; ++i) {
+		runners[i].cursor = &cursor;
+		runners[i].func = &func;
+		runners[i].runner = i;
+		to_join[i] = &runners[i];
+	}
+	if (queue.fork_join(to_join) == Task::Status::Completed) { return; }
+	// every runner is done: runner 0's state is not shared with any other thread.
+	while (auto const chunk = cursor.next()) { func(std::size_t{}, chunk->begin, chunk->end); }
+}
+} // namespace detail
+
+/// \brief Invokes func(index) for each index in [begin, end).
+template <std::invocable<std::size_t> FuncT>
+void parallel_for(Queue& queue, std::size_t const begin, std::size_t const end, FuncT func, Partition const& partition = {}) {
+	if (begin >= end) { return; }
+	auto const plan = detail::make_plan(queue, end - begin, partition);
+	auto chunk = [&func](std::size_t /*runner*/, std::size_t const first, std::size_t const last) {
+		for (auto i = first; i < last; ++i) { func(i); }
+	};
+	detail::run_chunks(queue, begin, end, plan, chunk);
+}
+
+/// \brief Invokes func(element) for each element in range.
+template <typename Type, std::invocable<Type&> FuncT>
+void parallel_for(Queue& queue, std::span<Type> range, FuncT func, Partition const& partition = {}) {
+	parallel_for(queue, 0, range.size(), [&](std::size_t const index) { func(range[index]); }, partition);
+}
+
+/// \brief Reduces map(index) over [begin, end) into init.
+/// reduce must be associative and commutative: chunks are combined in no particular order.
+template <typename Type, std::invocable<std::size_t> MapT, std::invocable<Type, Type> ReduceT>
+[[nodiscard]] auto parallel_reduce(Queue& queue, std::size_t const begin, std::size_t const end, Type init, MapT map, ReduceT reduce,
+								   Partition const& partition = {}) -> Type {
+	if (begin >= end) { return init; }
+	auto const plan = detail::make_plan(queue, end - begin, partition);
+	auto partials = std::vector<std::optional<Type>>(plan.runner_count);
+	auto chunk = [&](std::size_t const runner, std::size_t const first, std::size_t const last) {
+		auto& partial = partials[runner];
+		for (auto i = first; i < last; ++i) {
+			if (partial) {
+				*partial = reduce(std::move(*partial), map(i));
+			} else {
+				partial.emplace(map(i));
+			}
+		}
+	};
+	detail::run_chunks(queue, begin, end, plan, chunk);
+	for (auto& partial : partials) {
+		if (partial) { init = reduce(std::move(init), std::move(*partial)); }
+	}
+	return init;
+}
+
+/// \brief Reduces all elements of range into init.
+template <typename Type, std::invocable<Type, Type> ReduceT>
+[[nodiscard]] auto parallel_reduce(Queue& queue, std::span<Type const> range, Type init, ReduceT reduce, Partition const& partition = {}) -> Type {
+	return parallel_reduce(queue, 0, range.size(), std::move(init), [range](std::size_t const index) { return range[index]; }, reduce, partition);
+}
+
+/// \brief Assigns func(input[i]) to output[i] for each element in input.
+template <typename InputT, typename OutputT, std::invocable<InputT const&> FuncT>
+void parallel_transform(Queue& queue, std::span<InputT const> input, std::span<OutputT> output, FuncT func, Partition const& partition = {}) {
+	auto const count = std::min(input.size(), output.size());
+	parallel_for(queue, 0, count, [&](std::size_t const index) { output[index] = func(input[index]); }, partition);
+}
+} // namespace klib::task
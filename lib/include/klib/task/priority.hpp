@@ -0,0 +1,6 @@
+#pragma once
+#include <cstdint>
+
+namespace klib::task {
+enum class Priority : std::int8_t { Low, Normal, High, COUNT_ };
+} // namespace klib::task
@@ -1,7 +1,13 @@
 #pragma once
+#include "klib/task/callable_task.hpp"
 #include "klib/task/queue_create_info.hpp"
 #include "klib/task/queue_fwd.hpp"
+#include "klib/task/queue_stats.hpp"
+#include "klib/task/schedule.hpp"
 #include "klib/task/task.hpp"
+#include "klib/task/timer_id.hpp"
+#include <chrono>
+#include <concepts>
 #include <memory>
 #include <span>
 
@@ -13,21 +19,79 @@ class Queue {
 	explicit Queue(CreateInfo create_info = {});
 
 	[[nodiscard]] auto thread_count() const -> ThreadCount;
+	/// \brief Number of running workers: differs from thread_count() only in elastic mode.
+	[[nodiscard]] auto active_thread_count() const -> ThreadCount;
+	/// \brief Number of groups the workers are split into, see QueueCreateInfo::worker_group_size.
+	[[nodiscard]] auto worker_group_count() const -> std::size_t;
 	[[nodiscard]] auto max_elements() const -> ElementCount;
 	[[nodiscard]] auto enqueued_count() const -> std::size_t;
 	[[nodiscard]] auto is_empty() const -> bool { return enqueued_count() == 0; }
 	[[nodiscard]] auto can_enqueue(std::size_t count = 1) const -> bool;
 
+	/// \brief Fails if the queue is full / draining or any Task is busy: a rejected batch is left untouched (priority included).
 	auto enqueue(Task& task) -> bool;
 	auto enqueue(std::span<Task* const> tasks) -> bool;
+	auto enqueue(Task& task, Priority priority) -> bool;
+	auto enqueue(std::span<Task* const> tasks, Priority priority) -> bool;
+	/// \brief Enqueue unless the queue is full or producers are blocked in enqueue_wait() / enqueue_for(): never jumps their line.
+	auto try_enqueue(Task& task) -> bool;
+	auto try_enqueue(std::span<Task* const> tasks) -> bool;
+	/// \brief Block until there is space for all tasks: blocked producers are woken by workers as they consume, in arrival order.
+	/// \returns false if tasks can never fit (more than max_elements).
+	auto enqueue_wait(Task& task) -> bool;
+	auto enqueue_wait(std::span<Task* const> tasks) -> bool;
+	/// \brief enqueue_wait() with a timeout: returns false if space did not free up in time.
+	auto enqueue_for(Task& task, std::chrono::nanoseconds timeout) -> bool;
+	auto enqueue_for(std::span<Task* const> tasks, std::chrono::nanoseconds timeout) -> bool;
+	/// \brief Enqueue tasks and help execute them on the calling thread until all are done.
+	/// \returns Dropped without running anything if the Queue is draining, or any task is busy / already observed (see Group::add()).
 	auto fork_join(std::span<Task* const> tasks) -> Task::Status;
 
+	/// \brief Enqueue a callable in a pooled Task owned by the Queue.
+	/// Slots are recycled once executed (or dropped): small callables are stored inline, no allocations in steady state.
+	template <std::invocable FuncT>
+	auto submit(FuncT&& func) -> bool {
+		auto* task = acquire_callable();
+		if (task == nullptr) { return false; }
+		task->emplace(std::forward<FuncT>(func));
+		return submit(*task);
+	}
+
+	/// \brief Mark a queued task as dropped in constant time, and request it to stop if it is already executing.
+	/// A cancelled task remains busy until a worker pops (and skips) it.
+	/// Only applies to tasks last enqueued on this Queue (or a Strand attached to it), others are left untouched.
+	/// \returns true if task was cancelled before it started executing.
+	auto cancel(Task& task) -> bool;
+
+	/// \brief Enqueue task once time has been reached, rounded up to the timer resolution.
+	/// task must outlive the timer (until it has fired or been cancelled).
+	/// If task cannot be enqueued when the timer fires (busy / queue full), it is retried on the next tick.
+	auto enqueue_at(Task& task, std::chrono::steady_clock::time_point time) -> TimerId;
+	auto enqueue_after(Task& task, std::chrono::nanoseconds delay) -> TimerId;
+	/// \brief Enqueue task every period, starting one period from now.
+	/// Firings are skipped if task cannot be enqueued at the time (still busy / queue full).
+	auto enqueue_every(Task& task, std::chrono::nanoseconds period) -> TimerId;
+	/// \brief Remove a pending timer: returns false if it does not exist (or has already fired once).
+	auto cancel_timer(TimerId id) -> bool;
+	[[nodiscard]] auto timer_count() const -> std::size_t;
+
+	/// \brief Merged counters of all workers, empty unless created with collect_stats.
+	[[nodiscard]] auto snapshot() const -> QueueStats;
+	/// \brief Most recent worker additions / retirements in elastic mode, oldest first.
+	[[nodiscard]] auto resize_history() const -> std::vector<ResizeEvent>;
+
+	/// \brief co_await queue.schedule() to resume the calling coroutine on a worker.
+	[[nodiscard]] auto schedule() -> Schedule { return Schedule{*this}; }
+
 	void pause();
 	void resume();
 	void drain_and_wait();
 	void drop_enqueued();
 
   private:
+	auto acquire_callable() -> detail::CallableTask*;
+	auto submit(detail::CallableTask& task) -> bool;
+
 	struct Impl;
 	struct Deleter {
 		void operator()(Impl* ptr) const noexcept;
@@ -1,15 +1,80 @@
 #pragma once
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 
 namespace klib::task {
-enum struct ThreadCount : std::uint8_t { Minimum = 1 };
+class ThreadPool;
+
+enum struct ThreadCount : std::uint32_t { Minimum = 1 }; // NOLINT(performance-enum-size)
 enum struct ElementCount : std::size_t { Unbounded = 0 }; // NOLINT(performance-enum-size)
 
+/// \brief Strategy used to distribute enqueued tasks among workers.
+/// Shared: all workers pop from a single queue.
+/// WorkStealing: each worker owns a deque, external enqueues go to a shared injection queue, idle workers steal from each other.
+enum class Scheduler : std::int8_t { Shared, WorkStealing };
+
+/// \brief How idle workers wait for new tasks.
+/// Adaptive: spin with a CPU pause, then yield, then park. Lowest enqueue-to-start latency for bursts of small tasks, at the cost of idle CPU time.
+/// Park (default): sleep immediately. Minimal CPU usage, suited to battery powered or shared hosts.
+enum class IdleMode : std::int8_t { Adaptive, Park };
+
+struct IdlePolicy {
+	IdleMode mode{IdleMode::Park};
+	std::chrono::nanoseconds spin_duration{std::chrono::microseconds{20}};
+	std::chrono::nanoseconds yield_duration{std::chrono::microseconds{100}};
+};
+
+/// \brief Placement of worker threads on CPUs.
+/// None: workers are not pinned.
+/// Compact: workers are pinned to consecutive CPUs, filling a NUMA node before moving to the next.
+/// Scatter: workers are pinned round-robin across NUMA nodes.
+/// Explicit: worker i is pinned to cpus[i % cpus.size()].
+/// PerNumaNode: workers are distributed round-robin across NUMA nodes, each may run on any CPU of its node.
+/// When workers span multiple NUMA nodes, tasks enqueued by a worker stay on its node and workers prefer tasks of their own node.
+/// NUMA topology is read from sysfs on Linux, other platforms are treated as a single node.
+enum class Affinity : std::int8_t { None, Compact, Scatter, Explicit, PerNumaNode };
+
+struct AffinityPolicy {
+	Affinity mode{Affinity::None};
+	/// \brief CPU indices used by Affinity::Explicit, copied on Queue construction.
+	std::span<unsigned const> cpus{};
+};
+
+/// \brief Elastic mode, enabled when max_threads exceeds thread_count (which becomes the minimum).
+/// Unpinned workers are added up to max_threads when the queue backs up: enqueued tasks per active worker exceed depth_per_thread,
+/// or a task waited longer than wait_threshold to start. Workers above the minimum retire after being idle for idle_timeout.
+struct ElasticPolicy {
+	ThreadCount max_threads{0};
+	std::size_t depth_per_thread{8};
+	std::chrono::nanoseconds wait_threshold{std::chrono::milliseconds{2}};
+	std::chrono::nanoseconds idle_timeout{std::chrono::seconds{2}};
+};
+
 [[nodiscard]] auto get_max_threads() -> ThreadCount;
 
 struct QueueCreateInfo {
 	ThreadCount thread_count{get_max_threads()};
+	/// \brief Bounded Shared queues split max_elements preallocated lock-free ring slots across their priority lanes (and worker groups).
+	/// A lane whose share is full spills into an intrusive list: no allocations on enqueue.
 	ElementCount max_elements{ElementCount::Unbounded};
+	Scheduler scheduler{Scheduler::Shared};
+	/// \brief If non-zero, a lower Priority lane that has not been served for this long is served before higher lanes.
+	std::chrono::nanoseconds lane_aging{};
+	IdlePolicy idle_policy{};
+	AffinityPolicy affinity{};
+	/// \brief Collect per-worker counters and latency histograms, see Queue::snapshot().
+	bool collect_stats{};
+	/// \brief Tick length of the timer wheel used by Queue::enqueue_at() and friends.
+	std::chrono::nanoseconds timer_resolution{std::chrono::milliseconds{1}};
+	ElasticPolicy elastic{};
+	/// \brief Workers are split into groups of up to this many (never spanning NUMA nodes), each with its own scheduler state.
+	/// Workers take tasks from other groups only when their own is empty, those on the same NUMA node first. 0: no limit.
+	std::size_t worker_group_size{64};
+	/// \brief Run on the workers of pool instead of creating threads: thread_count, idle_policy, affinity and elastic are then ignored.
+	ThreadPool* pool{};
+	/// \brief Relative share of pool workers while other attached Queues are backed up too.
+	std::uint32_t weight{1};
 };
 } // namespace klib::task
@@ -0,0 +1,49 @@
+#pragma once
+#include "klib/task/queue_create_info.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace klib::task {
+/// \brief Log2 histogram of durations: bucket 0 counts zero, bucket i counts [2^(i-1), 2^i) nanoseconds.
+struct Histogram {
+	static constexpr auto bucket_count_v = std::size_t{40};
+
+	[[nodiscard]] static auto upper_bound(std::size_t bucket) -> std::chrono::nanoseconds;
+
+	/// \brief Upper bound of the bucket containing the pct-th percentile sample.
+	[[nodiscard]] auto percentile(double pct) const -> std::chrono::nanoseconds;
+
+	auto operator+=(Histogram const& rhs) -> Histogram&;
+
+	std::array<std::uint64_t, bucket_count_v> buckets{};
+	std::uint64_t count{};
+};
+
+struct WorkerStats {
+	std::uint64_t executed{};
+	std::chrono::nanoseconds busy_time{};
+	std::chrono::nanoseconds idle_time{};
+};
+
+enum class ResizeReason : std::int8_t { Depth, WaitTime, Idle };
+
+/// \brief Change in the number of active workers of an elastic Queue.
+struct ResizeEvent {
+	std::chrono::steady_clock::time_point time{};
+	ThreadCount thread_count{};
+	ResizeReason reason{};
+};
+
+struct QueueStats {
+	/// \brief One entry per (potential) worker, followed by one for tasks executed by fork_join callers.
+	std::vector<WorkerStats> workers{};
+	std::size_t depth_high_water{};
+	/// \brief Worker threads started so far, initial ones included (elastic growth starts more).
+	std::uint64_t worker_starts{};
+	Histogram start_latency{};
+	Histogram execute_duration{};
+};
+} // namespace klib::task
@@ -0,0 +1,35 @@
+#pragma once
+#include "klib/task/queue_fwd.hpp"
+#include "klib/task/task.hpp"
+#include <coroutine>
+
+namespace klib::task {
+/// \brief Awaitable that resumes the awaiting coroutine on a Queue worker.
+/// If the Queue rejects the Task the coroutine resumes immediately on the awaiting thread,
+/// if the Task is dropped it resumes on the dropping thread.
+class Schedule : public Task {
+  public:
+	Schedule() = default;
+
+	explicit Schedule(Queue& queue) : m_queue(&queue) {}
+
+	auto resume_on(Queue& queue, std::coroutine_handle<> handle) -> bool;
+
+	[[nodiscard]] auto await_ready() const -> bool { return m_queue == nullptr; }
+	auto await_suspend(std::coroutine_handle<> const handle) -> bool { return resume_on(*m_queue, handle); }
+	void await_resume() const {}
+
+  private:
+	class Resumer : public Observer {
+	  public:
+		void on_finalized(Status status) final;
+
+		std::coroutine_handle<> handle{};
+	};
+
+	void execute() final {}
+
+	Queue* m_queue{};
+	Resumer m_resumer{};
+};
+} // namespace klib::task
@@ -0,0 +1,55 @@
+#pragma once
+#include "klib/task/callback_guard.hpp"
+#include "klib/task/queue_fwd.hpp"
+#include "klib/task/task.hpp"
+#include <atomic>
+#include <cstddef>
+
+namespace klib::task {
+/// \brief Serial executor on top of a Queue: Tasks enqueued to a Strand run one at a time, in FIFO order, on the Queue's workers.
+/// Uses no dedicated threads, and no locks are held while a Task runs; multiple Strands on the same Queue run in parallel.
+/// If the Queue rejects the Strand (full / draining), its Tasks run inline on the thread that would have enqueued it,
+/// one turn at a time, until the Queue accepts the Strand again or none are left. If the Queue drops the Strand's turn, all its pending Tasks are dropped.
+class Strand {
+  public:
+	Strand(Strand const&) = delete;
+	Strand(Strand&&) = delete;
+	auto operator=(Strand const&) -> Strand& = delete;
+	auto operator=(Strand&&) -> Strand& = delete;
+
+	explicit Strand(Queue& queue) : m_queue(&queue) {}
+
+	~Strand();
+
+	void enqueue(Task& task);
+
+	[[nodiscard]] auto pending_count() const -> std::size_t { return m_pending; }
+	[[nodiscard]] auto is_idle() const -> bool { return m_pending == 0; }
+
+	void wait();
+
+  private:
+	struct Runner : Task, Task::Observer {
+		explicit Runner(Strand& strand) : strand(&strand) {}
+
+		void execute() final;
+		void on_finalized(Status status) final;
+
+		Strand* strand;
+	};
+
+	void schedule();
+	void run(std::size_t budget);
+	void on_turn_end(Status status);
+	void drop_pending();
+	[[nodiscard]] auto pop() -> Task*;
+
+	Queue* m_queue;
+	Runner m_runner{*this};
+	// producers push onto m_stack, the (single) running turn consumes from m_head.
+	std::atomic<Task*> m_stack{};
+	Task* m_head{};
+	std::atomic<std::size_t> m_pending{};
+	detail::CallbackGuard m_in_callback{};
+};
+} // namespace klib::task
@@ -1,14 +1,25 @@
 #pragma once
 #include "klib/task/id.hpp"
+#include "klib/task/priority.hpp"
 #include "klib/task/status.hpp"
 #include "klib/task/task_fwd.hpp"
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <span>
 
 namespace klib::task {
+namespace detail {
+class TaskLinks;
+class CallablePool;
+} // namespace detail
+
 class Task {
   public:
 	using Status = task::Status;
 	using Id = task::Id;
+	using Priority = task::Priority;
 
 	virtual ~Task() = default;
 
@@ -21,13 +32,47 @@ class Task {
 	[[nodiscard]] auto get_id() const -> Id { return m_id; }
 	[[nodiscard]] auto get_status() const -> Status { return m_status; }
 	[[nodiscard]] auto is_busy() const -> bool { return m_busy; }
+	/// \brief Exception thrown by the last execute(), if any. Only meaningful once the Task is no longer busy.
+	[[nodiscard]] auto get_exception() const -> std::exception_ptr { return m_exception; }
+
+	[[nodiscard]] auto get_priority() const -> Priority { return m_priority; }
+	void set_priority(Priority const priority) { m_priority = priority; }
 
 	void wait() { m_busy.wait(true); }
+	/// \brief Wait until the Task is no longer busy, or the timeout / deadline is reached.
+	/// \returns false on timeout.
+	auto wait_for(std::chrono::nanoseconds timeout) -> bool;
+	auto wait_until(std::chrono::steady_clock::time_point deadline) -> bool;
+
+	/// \brief Ask a running execute() to return early: it is expected to poll stop_requested().
+	/// Reset every time the Task is enqueued.
+	void request_stop() { m_stop_requested = true; }
+	[[nodiscard]] auto stop_requested() const -> bool { return m_stop_requested; }
 
   protected:
 	virtual void execute() = 0;
+	/// \brief Called every time the Task is enqueued, before it is queued: clear any state left by a previous run.
+	virtual void on_reset() {}
 
   private:
+	// notified after the Task has been finalized: the Task itself may already be destroyed or re-enqueued.
+	class Observer {
+	  public:
+		Observer(Observer const&) = delete;
+		Observer(Observer&&) = delete;
+		auto operator=(Observer const&) -> Observer& = delete;
+		auto operator=(Observer&&) -> Observer& = delete;
+
+		Observer() = default;
+		virtual ~Observer() = default;
+
+		virtual void on_finalized(Status status) = 0;
+	};
+
+	// owner: the executor that will run (or drop) the Task, checked by Queue::cancel().
+	void on_enqueued(void const* owner);
+	// on_enqueued() if the Task is not busy, as a single atomic transition: concurrent claims of the same Task fail.
+	[[nodiscard]] auto try_claim(void const* owner) -> bool;
 	void do_execute();
 	void do_drop();
 
@@ -35,8 +80,31 @@ class Task {
 
 	std::atomic<Status> m_status{};
 	std::atomic<bool> m_busy{};
+	std::atomic<bool> m_stop_requested{};
 	Id m_id{Id::None};
+	Priority m_priority{Priority::Normal};
+	Observer* m_observer{};
+	std::atomic<void const*> m_owner{};
+	std::exception_ptr m_exception{};
+	std::int64_t m_enqueued_at{}; // steady_clock nanoseconds, only set when collecting stats or elastic.
+	// intrusive links owned by the queue backend while enqueued.
+	Task* m_next{};
+	Task* m_prev{};
 
 	friend class Queue;
+	friend class Graph;
+	friend class Group;
+	friend class Schedule;
+	friend class Strand;
+	friend class Dispatcher;
+	friend class Notifier;
+	friend class detail::TaskLinks;
+	friend class detail::CallablePool;
 };
+
+/// \brief Wait until any of tasks is no longer busy: the calling thread sleeps until one of them is finalized, without polling.
+/// \returns The first Task in tasks that is not busy, nullptr if tasks is empty (or on timeout).
+auto wait_any(std::span<Task* const> tasks) -> Task*;
+auto wait_any_for(std::span<Task* const> tasks, std::chrono::nanoseconds timeout) -> Task*;
+auto wait_any_until(std::span<Task* const> tasks, std::chrono::steady_clock::time_point deadline) -> Task*;
 } // namespace klib::task
@@ -0,0 +1,34 @@
+#pragma once
+#include "klib/task/queue_create_info.hpp"
+#include <cstddef>
+#include <memory>
+
+namespace klib::task {
+struct ThreadPoolCreateInfo {
+	ThreadCount thread_count{get_max_threads()};
+	IdlePolicy idle_policy{};
+	AffinityPolicy affinity{};
+};
+
+/// \brief Worker threads shared by all Queues created with QueueCreateInfo::pool.
+/// Workers serve attached Queues round-robin, running up to QueueCreateInfo::weight tasks of one Queue in a row.
+/// Must outlive all attached Queues.
+class ThreadPool {
+  public:
+	using CreateInfo = ThreadPoolCreateInfo;
+
+	explicit ThreadPool(CreateInfo create_info = {});
+
+	[[nodiscard]] auto thread_count() const -> ThreadCount;
+	[[nodiscard]] auto queue_count() const -> std::size_t;
+
+  private:
+	struct Impl;
+	struct Deleter {
+		void operator()(Impl* ptr) const noexcept;
+	};
+	std::unique_ptr<Impl, Deleter> m_impl{};
+
+	friend class Queue;
+};
+} // namespace klib::task
@@ -0,0 +1,6 @@
+#pragma once
+#include <cstdint>
+
+namespace klib::task {
+enum struct TimerId : std::uint64_t { None = 0 }; // NOLINT(performance-enum-size)
+} // namespace klib::task
@@ -0,0 +1,111 @@
+#pragma once
+#include "klib/task/task.hpp"
+#include <cassert>
+#include <concepts>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace klib::task {
+template <typename Type>
+class TypedTask;
+
+/// \brief Non-owning view of the result of a TypedTask.
+/// The result is stored inline in the TypedTask, which must outlive all its Futures.
+template <typename Type>
+class Future {
+  public:
+	Future() = default;
+
+	explicit Future(TypedTask<Type>& task) : m_task(&task) {}
+
+	[[nodiscard]] auto is_valid() const -> bool { return m_task != nullptr; }
+	[[nodiscard]] auto is_ready() const -> bool { return m_task != nullptr && !m_task->is_busy(); }
+	[[nodiscard]] auto get_status() const -> Status { return m_task == nullptr ? Status::None : m_task->get_status(); }
+
+	void wait() const {
+		if (m_task != nullptr) { m_task->wait(); }
+	}
+
+	/// \brief Waits for the task, rethrows any exception thrown by it.
+	/// \returns Pointer to the result, null unless the task completed.
+	[[nodiscard]] auto get_if() const -> Type*
+		requires(!std::is_void_v<Type>)
+	{
+		if (!rethrow_if_failed()) { return nullptr; }
+		return m_task->get_result();
+	}
+
+	/// \brief Waits for the task, rethrows any exception thrown by it.
+	/// Requires the task to have completed.
+	auto get() const -> decltype(auto) {
+		if constexpr (std::is_void_v<Type>) {
+			rethrow_if_failed();
+		} else {
+			auto* ret = get_if();
+			assert(ret != nullptr);
+			return static_cast<Type&>(*ret);
+		}
+	}
+
+  private:
+	auto rethrow_if_failed() const -> bool {
+		if (m_task == nullptr) { return false; }
+		wait();
+		if (auto const exception = m_task->get_exception()) { std::rethrow_exception(exception); }
+		return true;
+	}
+
+	TypedTask<Type>* m_task{};
+};
+
+/// \brief Task that produces a result of type Type.
+/// Derived types implement compute() instead of execute().
+template <typename Type>
+class TypedTask : public Task {
+  public:
+	[[nodiscard]] auto get_future() -> Future<Type> { return Future<Type>{*this}; }
+
+	/// \brief Result of the last execution, null unless it completed (and the task has not been enqueued since).
+	[[nodiscard]] auto get_result() -> Type* {
+		if (is_busy() || get_status() != Status::Completed || !m_result) { return nullptr; }
+		return &*m_result;
+	}
+
+  protected:
+	virtual auto compute() -> Type = 0;
+
+  private:
+	void execute() final { m_result.emplace(compute()); }
+
+	void on_reset() final { m_result.reset(); }
+
+	std::optional<Type> m_result{};
+};
+
+template <>
+class TypedTask<void> : public Task {
+  public:
+	[[nodiscard]] auto get_future() -> Future<void> { return Future<void>{*this}; }
+
+  protected:
+	virtual void compute() = 0;
+
+  private:
+	void execute() final { compute(); }
+};
+
+/// \brief TypedTask that invokes a stored callable.
+template <std::invocable FuncT>
+class FuncTask : public TypedTask<std::invoke_result_t<FuncT&>> {
+  public:
+	explicit FuncTask(FuncT func) : m_func(std::move(func)) {}
+
+  private:
+	auto compute() -> std::invoke_result_t<FuncT&> final { return std::invoke(m_func); }
+
+	FuncT m_func;
+};
+} // namespace klib::task
@@ -2,19 +2,25 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
 #include <cassert>
+#include <charconv>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <deque>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 #include <mutex>
 #include <numeric>
+#include <optional>
 #include <print>
 #include <ranges>
+#include <shared_mutex>
 #include <string_view>
 #include <thread>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -53,15 +59,1345 @@ auto klib::to_version(std::string_view text) -> Version {
 
 // task
 
+#include "klib/task/callback_guard.hpp"
+#include "klib/task/dispatcher.hpp"
+#include "klib/task/graph.hpp"
+#include "klib/task/group.hpp"
+#include "klib/task/notifier.hpp"
 #include "klib/task/queue.hpp"
+#include "klib/task/strand.hpp"
+#include "klib/task/thread_pool.hpp"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 namespace klib {
 namespace task {
+class detail::TaskLinks {
+  public:
+	[[nodiscard]] static auto next(Task& task) -> Task*& { return task.m_next; }
+	[[nodiscard]] static auto prev(Task& task) -> Task*& { return task.m_prev; }
+};
+
+// slots are never freed while the pool is alive: steady state submits only recycle.
+// a slot observes itself (observers are reset on finalize) to return to the pool once executed / dropped.
+// acquire / release never lock: free slots form a Treiber stack of indices, its head is tagged with a generation against ABA.
+class detail::CallablePool {
+  public:
+	CallablePool(CallablePool const&) = delete;
+	CallablePool(CallablePool&&) = delete;
+	auto operator=(CallablePool const&) -> CallablePool& = delete;
+	auto operator=(CallablePool&&) -> CallablePool& = delete;
+
+	CallablePool() = default;
+
+	~CallablePool() {
+		for (auto& chunk : m_chunks) { delete[] chunk.load(); } // NOLINT(cppcoreguidelines-owning-memory)
+	}
+
+	[[nodiscard]] auto acquire() -> CallableTask* {
+		auto* ret = pop();
+		if (ret == nullptr) { ret = &claim_slot(); }
+		ret->m_observer = ret;
+		return ret;
+	}
+
+	// for slots that were rejected instead of enqueued.
+	void release(CallableTask& task) {
+		auto& slot = static_cast<Slot&>(task);
+		slot.m_observer = nullptr;
+		release(slot);
+	}
+
+  private:
+	struct Slot : CallableTask, Task::Observer {
+		void on_finalized(Status /*status*/) final { pool->release(*this); }
+
+		CallablePool* pool{};
+		std::uint32_t index{};
+		// index + 1 of the next free slot, 0 if none.
+		std::atomic<std::uint32_t> next_free{};
+	};
+
+	// chunk k holds base_v << k slots: a chunk is only allocated when the first of its slots is claimed.
+	static constexpr auto base_v = std::size_t{64};
+	static constexpr auto chunk_count_v = std::size_t{26};
+
+	[[nodiscard]] static constexpr auto locate(std::size_t const index) -> std::pair<std::size_t, std::size_t> {
+		auto const chunk = std::size_t(std::bit_width((index / base_v) + 1) - 1);
+		return {chunk, index - (base_v * ((std::size_t{1} << chunk) - 1))};
+	}
+
+	// the chunk of a slot that has been claimed is always allocated.
+	[[nodiscard]] auto slot_at(std::uint32_t const index) -> Slot& {
+		auto const [chunk, offset] = locate(index);
+		return m_chunks.at(chunk).load(std::memory_order_acquire)[offset];
+	}
+
+	[[nodiscard]] auto claim_slot() -> Slot& {
+		auto const index = m_size.fetch_add(1);
+		auto const [chunk, offset] = locate(index);
+		auto& ptr = m_chunks.at(chunk);
+		auto* slots = ptr.load(std::memory_order_acquire);
+		if (slots == nullptr) {
+			auto* fresh = new Slot[base_v << chunk]; // NOLINT(cppcoreguidelines-owning-memory)
+			if (ptr.compare_exchange_strong(slots, fresh, std::memory_order_acq_rel)) {
+				slots = fresh;
+			} else {
+				delete[] fresh; // NOLINT(cppcoreguidelines-owning-memory)
+			}
+		}
+		auto& ret = slots[offset];
+		ret.pool = this;
+		ret.index = std::uint32_t(index);
+		return ret;
+	}
+
+	[[nodiscard]] static auto retag(std::uint64_t const head, std::uint32_t const link) -> std::uint64_t {
+		return (((head >> 32) + 1) << 32) | link;
+	}
+
+	[[nodiscard]] auto pop() -> Slot* {
+		auto head = m_free.load(std::memory_order_acquire);
+		while (auto const link = std::uint32_t(head)) {
+			auto& slot = slot_at(link - 1);
+			// may be stale if slot was popped concurrently: the tag makes the exchange fail then.
+			auto const next = slot.next_free.load(std::memory_order_relaxed);
+			if (m_free.compare_exchange_weak(head, retag(head, next), std::memory_order_acquire)) { return &slot; }
+		}
+		return nullptr;
+	}
+
+	void release(Slot& slot) {
+		slot.reset();
+		auto head = m_free.load(std::memory_order_relaxed);
+		do {
+			slot.next_free.store(std::uint32_t(head), std::memory_order_relaxed);
+		} while (!m_free.compare_exchange_weak(head, retag(head, slot.index + 1), std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	std::array<std::atomic<Slot*>, chunk_count_v> m_chunks{};
+	std::atomic<std::uint32_t> m_size{};
+	// generation << 32 | (index + 1) of the top free slot.
+	std::atomic<std::uint64_t> m_free{};
+};
+
+namespace {
+constexpr auto cache_line_v = std::size_t{64};
+constexpr auto no_worker_v = std::size_t(-1);
+
+struct WorkerContext {
+	void const* owner{};
+	std::size_t index{no_worker_v};
+};
+
+thread_local auto t_worker = WorkerContext{}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void cpu_relax() {
+#if defined(_WIN32)
+	YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	asm volatile("yield");
+#else
+	std::this_thread::yield();
+#endif
+}
+
+// parses a sysfs CPU / node list, eg "0-3,8,10-11".
+[[nodiscard]] auto parse_cpu_list(std::string_view text) -> std::vector<unsigned> {
+	auto const parse = [](std::string_view const in, unsigned& out) { return std::from_chars(in.data(), in.data() + in.size(), out).ec == std::errc{}; };
+	auto ret = std::vector<unsigned>{};
+	while (!text.empty()) {
+		auto const comma = text.find(',');
+		auto const range = text.substr(0, comma);
+		text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+		auto const dash = range.find('-');
+		auto first = unsigned{};
+		if (!parse(range.substr(0, dash), first)) { continue; }
+		auto last = first;
+		if (dash != std::string_view::npos && !parse(range.substr(dash + 1), last)) { continue; }
+		for (auto cpu = first; cpu <= last; ++cpu) { ret.push_back(cpu); }
+	}
+	return ret;
+}
+
+// CPUs available to this process, grouped by NUMA node.
+struct Topology {
+	std::vector<std::vector<unsigned>> nodes{};
+
+	[[nodiscard]] static auto query() -> Topology {
+		auto ret = Topology{};
+#if defined(__linux__)
+		auto allowed = cpu_set_t{};
+		if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) { CPU_ZERO(&allowed); }
+		auto const is_allowed = [&allowed](unsigned const cpu) { return cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed); };
+		auto const read_list = [](std::string const& path) {
+			auto file = std::ifstream{path};
+			auto line = std::string{};
+			std::getline(file, line);
+			return parse_cpu_list(line);
+		};
+		for (auto const node : read_list("/sys/devices/system/node/online")) {
+			auto cpus = read_list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+			std::erase_if(cpus, [&](unsigned const cpu) { return !is_allowed(cpu); });
+			if (!cpus.empty()) { ret.nodes.push_back(std::move(cpus)); }
+		}
+#endif
+		if (ret.nodes.empty()) {
+			auto& cpus = ret.nodes.emplace_back(std::max(std::thread::hardware_concurrency(), 1u));
+			std::iota(cpus.begin(), cpus.end(), 0u);
+		}
+		return ret;
+	}
+
+	[[nodiscard]] auto node_of(unsigned const cpu) const -> std::size_t {
+		for (auto node = std::size_t{}; node < nodes.size(); ++node) {
+			if (std::ranges::find(nodes[node], cpu) != nodes[node].end()) { return node; }
+		}
+		return 0;
+	}
+};
+
+struct WorkerPlacement {
+	std::vector<unsigned> cpus{}; // empty: not pinned.
+	std::size_t node{};
+};
+
+[[nodiscard]] auto place_workers(QueueCreateInfo const& create_info) -> std::vector<WorkerPlacement> {
+	auto const& affinity = create_info.affinity;
+	auto ret = std::vector<WorkerPlacement>(std::size_t(create_info.thread_count));
+	if (affinity.mode == Affinity::None || (affinity.mode == Affinity::Explicit && affinity.cpus.empty())) { return ret; }
+	auto const topology = Topology::query();
+	auto const& nodes = topology.nodes;
+	auto compact = std::vector<WorkerPlacement>{};
+	if (affinity.mode == Affinity::Compact) {
+		for (auto node = std::size_t{}; node < nodes.size(); ++node) {
+			for (auto const cpu : nodes[node]) { compact.push_back(WorkerPlacement{.cpus = {cpu}, .node = node}); }
+		}
+	}
+	for (auto i = std::size_t{}; i < ret.size(); ++i) {
+		auto& placement = ret[i];
+		switch (affinity.mode) {
+		case Affinity::Compact: placement = compact[i % compact.size()]; break;
+		case Affinity::Scatter: {
+			placement.node = i % nodes.size();
+			auto const& cpus = nodes[placement.node];
+			placement.cpus = {cpus[(i / nodes.size()) % cpus.size()]};
+			break;
+		}
+		case Affinity::Explicit: {
+			auto const cpu = affinity.cpus[i % affinity.cpus.size()];
+			placement = WorkerPlacement{.cpus = {cpu}, .node = topology.node_of(cpu)};
+			break;
+		}
+		case Affinity::PerNumaNode:
+			placement.node = i % nodes.size();
+			placement.cpus = nodes[placement.node];
+			break;
+		default: break;
+		}
+	}
+	return ret;
+}
+
+void pin_current_thread(std::span<unsigned const> cpus) {
+	if (cpus.empty()) { return; }
+#if defined(_WIN32)
+	auto mask = DWORD_PTR{};
+	for (auto const cpu : cpus) {
+		if (cpu < sizeof(DWORD_PTR) * 8) { mask |= DWORD_PTR{1} << cpu; }
+	}
+	if (mask != 0) { SetThreadAffinityMask(GetCurrentThread(), mask); }
+#elif defined(__linux__)
+	auto set = cpu_set_t{};
+	CPU_ZERO(&set);
+	for (auto const cpu : cpus) {
+		if (cpu < CPU_SETSIZE) { CPU_SET(cpu, &set); }
+	}
+	sched_setaffinity(0, sizeof(set), &set);
+#endif
+}
+
+class Backend {
+  public:
+	Backend(Backend const&) = delete;
+	Backend(Backend&&) = delete;
+	auto operator=(Backend const&) = delete;
+	auto operator=(Backend&&) = delete;
+
+	Backend() = default;
+	virtual ~Backend() = default;
+
+	virtual void push(std::span<Task* const> tasks, std::size_t worker) = 0;
+	[[nodiscard]] virtual auto pop(std::size_t worker) -> Task* = 0;
+	virtual void pop_all(std::vector<Task*>& out) = 0;
+	[[nodiscard]] virtual auto group_count() const -> std::size_t { return 1; }
+};
+
+using Links = detail::TaskLinks;
+
+// Doubly linked list threaded through the enqueued Tasks: never allocates.
+class IntrusiveList {
+  public:
+	[[nodiscard]] auto is_empty() const -> bool { return m_head == nullptr; }
+
+	// chain: first -> ... -> last via Links::next, prev links are (re)built here.
+	void push_back(Task* first, Task* last) {
+		Links::prev(*first) = m_tail;
+		for (auto* task = first; task != last; task = Links::next(*task)) { Links::prev(*Links::next(*task)) = task; }
+		Links::next(*last) = nullptr;
+		if (m_tail != nullptr) {
+			Links::next(*m_tail) = first;
+		} else {
+			m_head = first;
+		}
+		m_tail = last;
+	}
+
+	void push_back(std::span<Task* const> tasks) {
+		if (tasks.empty()) { return; }
+		for (auto i = std::size_t{1}; i < tasks.size(); ++i) { Links::next(*tasks[i - 1]) = tasks[i]; }
+		push_back(tasks.front(), tasks.back());
+	}
+
+	[[nodiscard]] auto pop_front() -> Task* {
+		auto* ret = m_head;
+		if (ret == nullptr) { return nullptr; }
+		m_head = Links::next(*ret);
+		if (m_head != nullptr) {
+			Links::prev(*m_head) = nullptr;
+		} else {
+			m_tail = nullptr;
+		}
+		return ret;
+	}
+
+	[[nodiscard]] auto pop_back() -> Task* {
+		auto* ret = m_tail;
+		if (ret == nullptr) { return nullptr; }
+		m_tail = Links::prev(*ret);
+		if (m_tail != nullptr) {
+			Links::next(*m_tail) = nullptr;
+		} else {
+			m_head = nullptr;
+		}
+		return ret;
+	}
+
+	void pop_all(std::vector<Task*>& out) {
+		while (auto* task = pop_front()) { out.push_back(task); }
+	}
+
+  private:
+	Task* m_head{};
+	Task* m_tail{};
+};
+
+// Producers push onto a lock-free Treiber stack (one CAS per push), consumers take the whole stack
+// under a mutex once their FIFO runs dry and reverse it into the FIFO. Never allocates.
+// The stack is only ever detached whole, so there is no ABA.
+class IntrusiveQueue {
+  public:
+	void push(std::span<Task* const> tasks) {
+		if (tasks.empty()) { return; }
+		// newest on top: tasks.back() -> ... -> tasks.front() -> previous top.
+		for (auto i = std::size_t{1}; i < tasks.size(); ++i) { Links::next(*tasks[i]) = tasks[i - 1]; }
+		auto* bottom = tasks.front();
+		auto* top = tasks.back();
+		auto head = m_stack.load(std::memory_order_relaxed);
+		do { Links::next(*bottom) = head; } while (!m_stack.compare_exchange_weak(head, top, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	[[nodiscard]] auto pop() -> Task* {
+		auto lock = std::scoped_lock{m_mutex};
+		if (m_fifo.is_empty()) { refill(); }
+		return m_fifo.pop_front();
+	}
+
+	void pop_all(std::vector<Task*>& out) {
+		auto lock = std::scoped_lock{m_mutex};
+		refill();
+		m_fifo.pop_all(out);
+	}
+
+  private:
+	// m_mutex must be locked.
+	void refill() {
+		auto* task = m_stack.exchange(nullptr, std::memory_order_acquire);
+		if (task == nullptr) { return; }
+		auto* last = task;
+		Task* reversed = nullptr;
+		while (task != nullptr) {
+			auto* next = Links::next(*task);
+			Links::next(*task) = reversed;
+			reversed = task;
+			task = next;
+		}
+		m_fifo.push_back(reversed, last);
+	}
+
+	alignas(cache_line_v) std::atomic<Task*> m_stack{};
+	alignas(cache_line_v) std::mutex m_mutex{};
+	IntrusiveList m_fifo{};
+};
+
+class SharedBackend : public Backend {
+  public:
+	void push(std::span<Task* const> tasks, std::size_t /*worker*/) final { m_queue.push(tasks); }
+
+	[[nodiscard]] auto pop(std::size_t /*worker*/) -> Task* final { return m_queue.pop(); }
+
+	void pop_all(std::vector<Task*>& out) final { m_queue.pop_all(out); }
+
+  private:
+	IntrusiveQueue m_queue{};
+};
+
+// Each worker owns a deque: it pushes to / pops from the back, thieves pop from the front.
+// Tasks enqueued from outside the worker set go to a shared injection queue.
+class StealingBackend : public Backend {
+  public:
+	explicit StealingBackend(std::size_t const worker_count) : m_locals(worker_count) {}
+
+	void push(std::span<Task* const> tasks, std::size_t const worker) final {
+		if (worker >= m_locals.size()) {
+			m_injection.push(tasks);
+			return;
+		}
+		auto& local = m_locals[worker];
+		auto lock = std::scoped_lock{local.mutex};
+		local.list.push_back(tasks);
+	}
+
+	[[nodiscard]] auto pop(std::size_t const worker) -> Task* final {
+		if (worker < m_locals.size()) {
+			if (auto* ret = pop_back(m_locals[worker])) { return ret; }
+		}
+		if (auto* ret = m_injection.pop()) { return ret; }
+		return steal(worker);
+	}
+
+	void pop_all(std::vector<Task*>& out) final {
+		m_injection.pop_all(out);
+		for (auto& local : m_locals) {
+			auto lock = std::scoped_lock{local.mutex};
+			local.list.pop_all(out);
+		}
+	}
+
+  private:
+	struct alignas(cache_line_v) Deque {
+		std::mutex mutex{};
+		IntrusiveList list{};
+	};
+
+	static auto pop_back(Deque& in) -> Task* {
+		auto lock = std::scoped_lock{in.mutex};
+		return in.list.pop_back();
+	}
+
+	static auto pop_front(Deque& in) -> Task* {
+		auto lock = std::scoped_lock{in.mutex};
+		return in.list.pop_front();
+	}
+
+	auto steal(std::size_t const worker) -> Task* {
+		auto const count = m_locals.size();
+		auto const start = worker < count ? worker + 1 : 0;
+		for (auto i = std::size_t{}; i < count; ++i) {
+			auto const victim = (start + i) % count;
+			if (victim == worker) { continue; }
+			if (auto* ret = pop_front(m_locals[victim])) { return ret; }
+		}
+		return nullptr;
+	}
+
+	std::vector<Deque> m_locals;
+	IntrusiveQueue m_injection{};
+};
+
+// Bounded lock-free MPMC ring (Vyukov): slots are preallocated, each carries a sequence number that
+// tells producers / consumers whether it is free / filled for the current lap.
+// Capacity is reserved by Queue::Impl before push, so producers never lap consumers; a producer may
+// only briefly spin on a slot whose consumer has claimed but not yet released it.
+class RingBackend : public Backend {
+  public:
+	explicit RingBackend(std::size_t const capacity) : m_slots(std::bit_ceil(capacity)), m_mask(m_slots.size() - 1) {
+		for (auto i = std::size_t{}; i < m_slots.size(); ++i) { m_slots[i].sequence.store(i, std::memory_order_relaxed); }
+	}
+
+	[[nodiscard]] auto capacity() const -> std::size_t { return m_slots.size(); }
+
+	void push(std::span<Task* const> tasks, std::size_t /*worker*/) final {
+		auto position = m_tail.value.fetch_add(tasks.size(), std::memory_order_relaxed);
+		for (auto* task : tasks) {
+			auto& slot = m_slots[position & m_mask];
+			while (slot.sequence.load(std::memory_order_acquire) != position) { cpu_relax(); }
+			slot.task = task;
+			slot.sequence.store(position + 1, std::memory_order_release);
+			++position;
+		}
+	}
+
+	[[nodiscard]] auto pop(std::size_t /*worker*/) -> Task* final {
+		auto position = m_head.value.load(std::memory_order_relaxed);
+		while (true) {
+			auto& slot = m_slots[position & m_mask];
+			auto const sequence = slot.sequence.load(std::memory_order_acquire);
+			auto const diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(position + 1);
+			if (diff < 0) { return nullptr; }
+			if (diff > 0) {
+				position = m_head.value.load(std::memory_order_relaxed);
+				continue;
+			}
+			if (m_head.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				auto* ret = slot.task;
+				slot.sequence.store(position + m_slots.size(), std::memory_order_release);
+				return ret;
+			}
+		}
+	}
+
+	void pop_all(std::vector<Task*>& out) final {
+		while (auto* task = pop(no_worker_v)) { out.push_back(task); }
+	}
+
+  private:
+	struct Slot {
+		std::atomic<std::size_t> sequence{};
+		Task* task{};
+	};
+
+	struct alignas(cache_line_v) Cursor {
+		std::atomic<std::size_t> value{};
+	};
+
+	std::vector<Slot> m_slots;
+	std::size_t m_mask;
+	Cursor m_head{};
+	Cursor m_tail{};
+};
+
+// A RingBackend holding a share of max_elements, spilling over into an intrusive list once full:
+// the lanes of a Queue preallocate max_elements slots between them, yet any one lane can hold every admitted Task.
+// Once Tasks have spilled, pushes keep spilling until the spill list has drained: the lane stays FIFO.
+class SpillingBackend : public Backend {
+  public:
+	explicit SpillingBackend(std::size_t const capacity) : m_ring(capacity) {}
+
+	void push(std::span<Task* const> tasks, std::size_t const worker) final {
+		if (m_spilled == 0 && try_reserve(tasks.size())) {
+			m_ring.push(tasks, worker);
+			return;
+		}
+		m_spilled += tasks.size();
+		m_spill.push(tasks, worker);
+	}
+
+	[[nodiscard]] auto pop(std::size_t const worker) -> Task* final {
+		if (auto* ret = m_ring.pop(worker)) {
+			--m_reserved;
+			return ret;
+		}
+		if (m_spilled == 0) { return nullptr; }
+		auto* ret = m_spill.pop(worker);
+		if (ret != nullptr) { --m_spilled; }
+		return ret;
+	}
+
+	void pop_all(std::vector<Task*>& out) final {
+		auto const previous = out.size();
+		m_ring.pop_all(out);
+		m_reserved -= out.size() - previous;
+		auto const ring_end = out.size();
+		m_spill.pop_all(out);
+		m_spilled -= out.size() - ring_end;
+	}
+
+  private:
+	[[nodiscard]] auto try_reserve(std::size_t const count) -> bool {
+		auto current = m_reserved.load();
+		do {
+			if (current + count > m_ring.capacity()) { return false; }
+		} while (!m_reserved.compare_exchange_weak(current, current + count));
+		return true;
+	}
+
+	RingBackend m_ring;
+	SharedBackend m_spill{};
+	std::atomic<std::size_t> m_reserved{};
+	std::atomic<std::size_t> m_spilled{};
+};
+
+// lane_count: lanes across the whole Queue (priorities * worker groups), that share max_elements.
+[[nodiscard]] auto create_lane_backend(QueueCreateInfo const& create_info, std::size_t const lane_count) -> std::unique_ptr<Backend> {
+	static constexpr auto min_ring_capacity_v = std::size_t{2};
+	switch (create_info.scheduler) {
+	case Scheduler::WorkStealing: return std::make_unique<StealingBackend>(std::size_t(create_info.thread_count));
+	default: break;
+	}
+	if (create_info.max_elements != ElementCount::Unbounded) {
+		auto const share = std::max(std::size_t(create_info.max_elements) / lane_count, min_ring_capacity_v);
+		return std::make_unique<SpillingBackend>(std::bit_floor(share));
+	}
+	return std::make_unique<SharedBackend>();
+}
+
+// One backend per Priority, higher lanes are always drained first.
+// With aging enabled, a lower lane that has not been served for that long is served next.
+class PriorityBackend : public Backend {
+  public:
+	static constexpr auto lane_count_v = std::size_t(Priority::COUNT_);
+
+	explicit PriorityBackend(QueueCreateInfo const& create_info, std::size_t const group_count = 1)
+		: m_aging(chr::duration_cast<chr::steady_clock::duration>(create_info.lane_aging)) {
+		for (auto& lane : m_lanes) { lane.backend = create_lane_backend(create_info, lane_count_v * group_count); }
+	}
+
+	void push(std::span<Task* const> tasks, std::size_t const worker) final {
+		while (!tasks.empty()) {
+			auto const priority = tasks.front()->get_priority();
+			auto const it = std::ranges::find_if(tasks, [priority](Task const* t) { return t->get_priority() != priority; });
+			auto const run = tasks.first(std::size_t(it - tasks.begin()));
+			auto& lane = get_lane(priority);
+			if (lane.count.fetch_add(run.size()) == 0 && is_aging()) { lane.served_at = now(); }
+			lane.backend->push(run, worker);
+			tasks = tasks.subspan(run.size());
+		}
+	}
+
+	[[nodiscard]] auto pop(std::size_t const worker) -> Task* final {
+		if (is_aging()) {
+			if (auto* ret = pop_starved(worker)) { return ret; }
+		}
+		for (auto& lane : std::views::reverse(m_lanes)) {
+			if (auto* ret = pop_from(lane, worker)) { return ret; }
+		}
+		return nullptr;
+	}
+
+	void pop_all(std::vector<Task*>& out) final {
+		for (auto& lane : m_lanes) {
+			auto const previous = out.size();
+			lane.backend->pop_all(out);
+			lane.count -= out.size() - previous;
+		}
+	}
+
+  private:
+	struct alignas(cache_line_v) Lane {
+		std::unique_ptr<Backend> backend{};
+		std::atomic<std::size_t> count{};
+		std::atomic<chr::steady_clock::rep> served_at{};
+	};
+
+	[[nodiscard]] static auto now() -> chr::steady_clock::rep { return chr::steady_clock::now().time_since_epoch().count(); }
+
+	[[nodiscard]] auto is_aging() const -> bool { return m_aging > chr::steady_clock::duration::zero(); }
+
+	[[nodiscard]] auto get_lane(Priority const priority) -> Lane& { return m_lanes.at(std::size_t(priority)); }
+
+	auto pop_from(Lane& lane, std::size_t const worker) -> Task* {
+		if (lane.count == 0) { return nullptr; }
+		auto* ret = lane.backend->pop(worker);
+		if (ret == nullptr) { return nullptr; }
+		--lane.count;
+		if (is_aging()) { lane.served_at = now(); }
+		return ret;
+	}
+
+	auto pop_starved(std::size_t const worker) -> Task* {
+		auto const threshold = now() - m_aging.count();
+		for (auto& lane : m_lanes | std::views::take(m_lanes.size() - 1)) {
+			if (lane.count == 0 || lane.served_at > threshold) { continue; }
+			if (auto* ret = pop_from(lane, worker)) { return ret; }
+		}
+		return nullptr;
+	}
+
+	std::array<Lane, lane_count_v> m_lanes{};
+	chr::steady_clock::duration m_aging;
+};
+
+// a worker's group and its index within the group.
+struct WorkerGroup {
+	std::size_t group{};
+	std::size_t local_index{};
+};
+
+// groups are formed per NUMA node, then split every group_size workers.
+[[nodiscard]] auto assign_groups(std::span<WorkerPlacement const> placements, std::size_t const group_size) -> std::vector<WorkerGroup> {
+	auto ret = std::vector<WorkerGroup>{};
+	ret.reserve(placements.size());
+	auto node_counts = std::vector<std::size_t>{};
+	auto keys = std::vector<std::pair<std::size_t, std::size_t>>{};
+	auto group_counts = std::vector<std::size_t>{};
+	for (auto const& placement : placements) {
+		if (placement.node >= node_counts.size()) { node_counts.resize(placement.node + 1); }
+		auto const index_in_node = node_counts[placement.node]++;
+		auto const key = std::pair{placement.node, group_size > 0 ? index_in_node / group_size : 0};
+		auto const group = std::size_t(std::ranges::find(keys, key) - keys.begin());
+		if (group == keys.size()) {
+			keys.push_back(key);
+			group_counts.push_back(0);
+		}
+		ret.push_back(WorkerGroup{.group = group, .local_index = group_counts[group]++});
+	}
+	return ret;
+}
+
+// One PriorityBackend per group of workers: workers push to their own group, and pop from it before taking from other groups.
+// Priorities are ordered within each group. Pushes from outside the worker set are distributed round-robin across groups.
+class GroupBackend : public Backend {
+  public:
+	explicit GroupBackend(QueueCreateInfo const& create_info, std::span<WorkerPlacement const> placements, std::vector<WorkerGroup> workers)
+		: m_workers(std::move(workers)) {
+		auto worker_counts = std::vector<std::size_t>{};
+		for (auto i = std::size_t{}; i < m_workers.size(); ++i) {
+			auto const group = m_workers[i].group;
+			if (group >= worker_counts.size()) {
+				worker_counts.resize(group + 1);
+				m_group_nodes.resize(group + 1);
+			}
+			++worker_counts[group];
+			m_group_nodes[group] = placements[i].node;
+		}
+		m_groups.reserve(worker_counts.size());
+		for (auto const count : worker_counts) {
+			auto group_create_info = create_info;
+			group_create_info.thread_count = ThreadCount(count);
+			m_groups.push_back(std::make_unique<PriorityBackend>(group_create_info, worker_counts.size()));
+		}
+	}
+
+	void push(std::span<Task* const> tasks, std::size_t const worker) final {
+		if (worker < m_workers.size()) {
+			auto const& local = m_workers[worker];
+			m_groups[local.group]->push(tasks, local.local_index);
+			return;
+		}
+		m_groups[m_next++ % m_groups.size()]->push(tasks, no_worker_v);
+	}
+
+	// other groups on the same node are tried before remote ones.
+	[[nodiscard]] auto pop(std::size_t const worker) -> Task* final {
+		auto own = m_groups.size();
+		if (worker < m_workers.size()) {
+			auto const& local = m_workers[worker];
+			if (auto* ret = m_groups[local.group]->pop(local.local_index)) { return ret; }
+			own = local.group;
+		}
+		auto const is_near = [&](std::size_t const group) { return own < m_groups.size() && m_group_nodes[group] == m_group_nodes[own]; };
+		auto const start = own < m_groups.size() ? own + 1 : 0;
+		for (auto const near : {true, false}) {
+			for (auto i = std::size_t{}; i < m_groups.size(); ++i) {
+				auto const group = (start + i) % m_groups.size();
+				if (group == own || is_near(group) != near) { continue; }
+				if (auto* ret = m_groups[group]->pop(no_worker_v)) { return ret; }
+			}
+		}
+		return nullptr;
+	}
+
+	void pop_all(std::vector<Task*>& out) final {
+		for (auto& group : m_groups) { group->pop_all(out); }
+	}
+
+	[[nodiscard]] auto group_count() const -> std::size_t final { return m_groups.size(); }
+
+  private:
+	std::vector<std::unique_ptr<Backend>> m_groups{};
+	std::vector<std::size_t> m_group_nodes{};
+	std::vector<WorkerGroup> m_workers{};
+	std::atomic<std::size_t> m_next{};
+};
+
+// Each worker accumulates into its own cache line, non-worker threads (fork_join callers) share the last one.
+class StatsCollector {
+  public:
+	using Buckets = std::array<std::atomic<std::uint64_t>, Histogram::bucket_count_v>;
+
+	struct alignas(cache_line_v) Counters {
+		std::atomic<std::uint64_t> executed{};
+		std::atomic<std::int64_t> busy_ns{};
+		std::atomic<std::int64_t> idle_ns{};
+		Buckets start_latency{};
+		Buckets execute_duration{};
+	};
+
+	explicit StatsCollector(std::size_t const worker_count) : m_counters(worker_count + 1) {}
+
+	[[nodiscard]] static auto now() -> std::int64_t { return chr::duration_cast<chr::nanoseconds>(chr::steady_clock::now().time_since_epoch()).count(); }
+
+	static void add(std::atomic<std::int64_t>& out, std::int64_t const ns) { out.fetch_add(std::max(ns, std::int64_t{}), std::memory_order_relaxed); }
+
+	static void record(Buckets& out, std::int64_t const ns) {
+		auto const bucket = std::min(std::size_t(std::bit_width(std::uint64_t(std::max(ns, std::int64_t{})))), Histogram::bucket_count_v - 1);
+		out[bucket].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] auto get_counters(std::size_t const worker) -> Counters& { return m_counters[std::min(worker, m_counters.size() - 1)]; }
+
+	void on_worker_started() { m_worker_starts.fetch_add(1, std::memory_order_relaxed); }
+
+	void on_depth(std::size_t const depth) {
+		auto current = m_depth_high_water.load(std::memory_order_relaxed);
+		while (depth > current && !m_depth_high_water.compare_exchange_weak(current, depth, std::memory_order_relaxed)) {}
+	}
+
+	[[nodiscard]] auto snapshot() const -> QueueStats {
+		auto const merge = [](Histogram& out, Buckets const& in) {
+			auto histogram = Histogram{};
+			for (auto i = std::size_t{}; i < in.size(); ++i) {
+				histogram.buckets.at(i) = in.at(i).load(std::memory_order_relaxed);
+				histogram.count += histogram.buckets.at(i);
+			}
+			out += histogram;
+		};
+		auto ret = QueueStats{
+			.depth_high_water = m_depth_high_water.load(std::memory_order_relaxed),
+			.worker_starts = m_worker_starts.load(std::memory_order_relaxed),
+		};
+		ret.workers.reserve(m_counters.size());
+		for (auto const& counters : m_counters) {
+			ret.workers.push_back(WorkerStats{
+				.executed = counters.executed.load(std::memory_order_relaxed),
+				.busy_time = chr::nanoseconds{counters.busy_ns.load(std::memory_order_relaxed)},
+				.idle_time = chr::nanoseconds{counters.idle_ns.load(std::memory_order_relaxed)},
+			});
+			merge(ret.start_latency, counters.start_latency);
+			merge(ret.execute_duration, counters.execute_duration);
+		}
+		return ret;
+	}
+
+  private:
+	std::vector<Counters> m_counters;
+	std::atomic<std::size_t> m_depth_high_water{};
+	std::atomic<std::uint64_t> m_worker_starts{};
+};
+
+// Hierarchical timer wheel (as used by classic kernel timers): level l has 64 slots spanning 64^l ticks each.
+// Insertion and cancellation are O(1); entries are cascaded into lower levels as the wheel turns.
+class TimerWheel {
+  public:
+	static constexpr auto slot_bits_v = 6;
+	static constexpr auto slot_count_v = std::size_t{1} << slot_bits_v;
+	static constexpr auto level_count_v = 4;
+	static constexpr auto max_delta_v = (std::uint64_t{1} << (slot_bits_v * level_count_v)) - 1;
+	static constexpr auto no_tick_v = std::numeric_limits<std::uint64_t>::max();
+
+	[[nodiscard]] auto is_empty() const -> bool { return m_size == 0; }
+	[[nodiscard]] auto size() const -> std::size_t { return m_size; }
+	[[nodiscard]] auto current_tick() const -> std::uint64_t { return m_current; }
+
+	// only valid while empty.
+	void reset(std::uint64_t const tick) { m_current = tick; }
+
+	auto add(Task& task, std::uint64_t const expiry, std::uint64_t const period) -> TimerId {
+		auto& entry = acquire();
+		entry.expiry = expiry;
+		entry.period = period;
+		entry.task = &task;
+		entry.id = to_id(entry);
+		insert(entry);
+		++m_size;
+		return entry.id;
+	}
+
+	// ids encode the Entry's index in the pool and its generation: no lookup table.
+	auto cancel(TimerId const id) -> bool {
+		auto const index = std::size_t(std::to_underlying(id) & index_mask_v);
+		if (id == TimerId::None || index >= m_pool.size()) { return false; }
+		auto& entry = m_pool[index];
+		if (entry.id != id) { return false; }
+		unlink(entry);
+		release(entry);
+		return true;
+	}
+
+	// earliest tick at which advance() has work to do (firing or cascading a non-empty slot), no_tick_v if empty.
+	[[nodiscard]] auto next_tick() const -> std::uint64_t {
+		if (is_empty()) { return no_tick_v; }
+		auto ret = no_tick_v;
+		for (auto level = 0; level < level_count_v; ++level) {
+			auto const& slots = m_slots.at(std::size_t(level));
+			auto const shift = slot_bits_v * level;
+			// first tick at or after current where this level's slots are visited.
+			auto const first = ((m_current + (std::uint64_t{1} << shift) - 1) >> shift);
+			for (auto offset = std::size_t{}; offset < slot_count_v; ++offset) {
+				auto const unit = first + offset;
+				if (slots.at(std::size_t(unit) & (slot_count_v - 1)) == nullptr) { continue; }
+				ret = std::min(ret, unit << shift);
+				break;
+			}
+		}
+		return ret;
+	}
+
+	// jumps over idle ticks up to (not past) tick.
+	void skip_to(std::uint64_t const tick) { m_current = std::max(m_current, std::min(tick, next_tick())); }
+
+	// expires the current tick and moves to the next one.
+	// enqueue(Task&) -> bool: one-shot entries that failed are retried on the next tick, periodic ones skip to their next period.
+	template <typename F>
+	void advance(F enqueue) {
+		if ((m_current & (slot_count_v - 1)) == 0) {
+			for (auto level = 1; level < level_count_v; ++level) {
+				auto const index = slot_index(m_current, level);
+				cascade(m_slots.at(std::size_t(level)).at(index));
+				if (index != 0) { break; }
+			}
+		}
+		auto* entry = std::exchange(m_slots.front().at(slot_index(m_current, 0)), nullptr);
+		while (entry != nullptr) {
+			auto* next = entry->next;
+			fire(*entry, enqueue);
+			entry = next;
+		}
+		++m_current;
+	}
+
+  private:
+	static constexpr auto index_bits_v = 32;
+	static constexpr auto index_mask_v = (std::uint64_t{1} << index_bits_v) - 1;
+
+	struct Entry {
+		Entry* prev{};
+		Entry* next{};
+		std::uint64_t expiry{};
+		std::uint64_t period{}; // zero: one-shot.
+		Task* task{};
+		TimerId id{}; // None while free.
+		Entry** slot{};
+		std::uint32_t index{};
+		std::uint32_t generation{};
+	};
+
+	[[nodiscard]] static auto slot_index(std::uint64_t const tick, int const level) -> std::size_t {
+		return std::size_t(tick >> (slot_bits_v * level)) & (slot_count_v - 1);
+	}
+
+	// generation starts at 1: ids are never None.
+	[[nodiscard]] static auto to_id(Entry const& entry) -> TimerId {
+		return TimerId{(std::uint64_t{entry.generation} << index_bits_v) | std::uint64_t{entry.index}};
+	}
+
+	auto acquire() -> Entry& {
+		auto* ret = m_free;
+		if (ret == nullptr) {
+			ret = &m_pool.emplace_back();
+			ret->index = std::uint32_t(m_pool.size() - 1);
+		} else {
+			m_free = ret->next;
+		}
+		if (++ret->generation == 0) { ret->generation = 1; }
+		return *ret;
+	}
+
+	// free entries are chained through next.
+	void release(Entry& entry) {
+		entry.id = TimerId::None;
+		entry.task = nullptr;
+		entry.slot = nullptr;
+		entry.prev = nullptr;
+		entry.next = m_free;
+		m_free = &entry;
+		--m_size;
+	}
+
+	void insert(Entry& entry) {
+		auto const delta = entry.expiry > m_current ? std::min(entry.expiry - m_current, max_delta_v) : 0;
+		auto const target = m_current + delta;
+		auto level = 0;
+		while (level + 1 < level_count_v && delta >= (std::uint64_t{1} << (slot_bits_v * (level + 1)))) { ++level; }
+		auto& head = m_slots.at(std::size_t(level)).at(slot_index(target, level));
+		entry.prev = nullptr;
+		entry.next = head;
+		if (head != nullptr) { head->prev = &entry; }
+		head = &entry;
+		entry.slot = &head;
+	}
+
+	static void unlink(Entry& entry) {
+		if (entry.prev != nullptr) {
+			entry.prev->next = entry.next;
+		} else {
+			*entry.slot = entry.next;
+		}
+		if (entry.next != nullptr) { entry.next->prev = entry.prev; }
+	}
+
+	void cascade(Entry*& slot) {
+		auto* entry = std::exchange(slot, nullptr);
+		while (entry != nullptr) {
+			auto* next = entry->next;
+			insert(*entry);
+			entry = next;
+		}
+	}
+
+	template <typename F>
+	void fire(Entry& entry, F& enqueue) {
+		if (entry.expiry > m_current) {
+			// clamped beyond the wheel's range, not due yet.
+			insert(entry);
+			return;
+		}
+		auto const enqueued = enqueue(*entry.task);
+		if (entry.period > 0) {
+			entry.expiry += entry.period;
+			if (entry.expiry <= m_current) { entry.expiry += (m_current - entry.expiry) / entry.period * entry.period + entry.period; }
+			insert(entry);
+			return;
+		}
+		if (!enqueued) {
+			entry.expiry = m_current + 1;
+			insert(entry);
+			return;
+		}
+		release(entry);
+	}
+
+	std::array<std::array<Entry*, slot_count_v>, level_count_v> m_slots{};
+	std::deque<Entry> m_pool{};
+	Entry* m_free{};
+	std::size_t m_size{};
+	std::uint64_t m_current{};
+};
+
+[[nodiscard]] auto create_backend(QueueCreateInfo const& create_info, std::span<WorkerPlacement const> placements) -> std::unique_ptr<Backend> {
+	auto workers = assign_groups(placements, create_info.worker_group_size);
+	auto const is_grouped = std::ranges::any_of(workers, [](WorkerGroup const& w) { return w.group > 0; });
+	if (is_grouped) { return std::make_unique<GroupBackend>(create_info, placements, std::move(workers)); }
+	return std::make_unique<PriorityBackend>(create_info);
+}
+
+// spins and then yields until ready() or the idle policy's budget runs out: returns false if the caller should park.
+template <typename F>
+[[nodiscard]] auto await_ready(IdlePolicy const& policy, F ready) -> bool {
+	if (policy.mode == IdleMode::Park) { return false; }
+	auto const spin_until = chr::steady_clock::now() + policy.spin_duration;
+	while (chr::steady_clock::now() < spin_until) {
+		if (ready()) { return true; }
+		cpu_relax();
+	}
+	auto const yield_until = chr::steady_clock::now() + policy.yield_duration;
+	while (chr::steady_clock::now() < yield_until) {
+		if (ready()) { return true; }
+		std::this_thread::yield();
+	}
+	return false;
+}
+
+// a Queue attached to a Pool.
+class PoolMember {
+  public:
+	PoolMember(PoolMember const&) = delete;
+	PoolMember(PoolMember&&) = delete;
+	auto operator=(PoolMember const&) = delete;
+	auto operator=(PoolMember&&) = delete;
+
+	PoolMember() = default;
+	virtual ~PoolMember() = default;
+
+	[[nodiscard]] virtual auto has_work() const -> bool = 0;
+	[[nodiscard]] virtual auto get_weight() const -> std::uint32_t = 0;
+	[[nodiscard]] virtual auto try_pop(std::size_t worker) -> Task* = 0;
+	// the member stays pinned by the Pool until execute_on() returns: Pool::detach() waits for it.
+	virtual void execute_on(Task& task, std::size_t worker) = 0;
+
+  private:
+	detail::CallbackGuard m_pinned{};
+
+	friend class Pool;
+};
+
+class Pool {
+  public:
+	Pool(Pool const&) = delete;
+	Pool(Pool&&) = delete;
+	auto operator=(Pool const&) = delete;
+	auto operator=(Pool&&) = delete;
+
+	explicit Pool(ThreadPoolCreateInfo const& create_info) : m_idle_policy(create_info.idle_policy) {
+		auto const queue_create_info = QueueCreateInfo{.thread_count = create_info.thread_count, .affinity = create_info.affinity};
+		m_placements = place_workers(queue_create_info);
+		m_threads.reserve(m_placements.size());
+		for (auto index = std::size_t{}; index < m_placements.size(); ++index) {
+			m_threads.emplace_back([this, index](std::stop_token const& s) { thunk(s, index); });
+		}
+	}
+
+	~Pool() {
+		assert(m_members.empty());
+		for (auto& thread : m_threads) { thread.request_stop(); }
+		wake_all();
+		m_threads.clear();
+	}
+
+	[[nodiscard]] auto thread_count() const -> ThreadCount { return ThreadCount(m_threads.size()); }
+	[[nodiscard]] auto get_placements() const -> std::span<WorkerPlacement const> { return m_placements; }
+
+	[[nodiscard]] auto member_count() const -> std::size_t {
+		auto lock = std::shared_lock{m_members_mutex};
+		return m_members.size();
+	}
+
+	void attach(PoolMember& member) {
+		auto lock = std::unique_lock{m_members_mutex};
+		m_members.push_back(&member);
+	}
+
+	// once this returns, workers no longer pop tasks from member, nor execute any popped from it.
+	void detach(PoolMember& member) {
+		{
+			auto lock = std::unique_lock{m_members_mutex};
+			std::erase(m_members, &member);
+		}
+		member.m_pinned.wait_idle();
+	}
+
+	void wake(std::size_t const count) {
+		if (m_sleeping == 0) { return; }
+		{ auto lock = std::scoped_lock{m_sleep_mutex}; }
+		if (count > 1) {
+			m_work_cv.notify_all();
+		} else {
+			m_work_cv.notify_one();
+		}
+	}
+
+	void wake_all() {
+		{ auto lock = std::scoped_lock{m_sleep_mutex}; }
+		m_work_cv.notify_all();
+	}
+
+  private:
+	// weighted round robin, per worker: up to weight tasks are popped from the current member before moving to the next one.
+	struct Cursor {
+		std::size_t member{};
+		std::uint32_t served{};
+	};
+
+	struct Popped {
+		PoolMember* member{};
+		Task* task{};
+	};
+
+	[[nodiscard]] auto has_work() const -> bool {
+		auto lock = std::shared_lock{m_members_mutex};
+		return std::ranges::any_of(m_members, [](PoolMember const* m) { return m->has_work(); });
+	}
+
+	// visits the current member twice: once its weight is used up, it is served again if no other member has work.
+	[[nodiscard]] auto pop(Cursor& cursor, std::size_t const worker) -> Popped {
+		auto lock = std::shared_lock{m_members_mutex};
+		if (m_members.empty()) { return {}; }
+		for (auto i = std::size_t{}; i <= m_members.size(); ++i) {
+			auto* member = m_members[cursor.member % m_members.size()];
+			if (cursor.served < member->get_weight()) {
+				if (auto* task = member->try_pop(worker)) {
+					// pinned under the lock: detach() either sees the pin, or this member is no longer listed.
+					member->m_pinned.enter();
+					++cursor.served;
+					return Popped{.member = member, .task = task};
+				}
+			}
+			++cursor.member;
+			cursor.served = 0;
+		}
+		return {};
+	}
+
+	void thunk(std::stop_token const& s, std::size_t const index) {
+		pin_current_thread(m_placements[index].cpus);
+		auto cursor = Cursor{.member = index};
+		while (!s.stop_requested()) {
+			if (auto const popped = pop(cursor, index); popped.task != nullptr) {
+				popped.member->execute_on(*popped.task, index);
+				popped.member->m_pinned.leave();
+				continue;
+			}
+			if (await_ready(m_idle_policy, [&] { return s.stop_requested() || has_work(); })) { continue; }
+			auto lock = std::unique_lock{m_sleep_mutex};
+			++m_sleeping;
+			m_work_cv.wait(lock, s, [this] { return has_work(); });
+			--m_sleeping;
+		}
+	}
+
+	IdlePolicy m_idle_policy{};
+	std::vector<WorkerPlacement> m_placements{};
+
+	mutable std::shared_mutex m_members_mutex{};
+	std::vector<PoolMember*> m_members{};
+
+	std::atomic<std::size_t> m_sleeping{};
+	std::mutex m_sleep_mutex{};
+	std::condition_variable_any m_work_cv{};
+
+	std::vector<std::jthread> m_threads{};
+};
+
+// Threads in wait_any() register one Record per Task, in the bucket of its address: Task::finalize() wakes the matching waiters.
+// Records are only looked up while some thread is parked, finalize() otherwise costs a single atomic load.
+class ParkingLot {
+  public:
+	struct Waiter {
+		std::mutex mutex{};
+		std::condition_variable cv{};
+		bool woken{};
+	};
+
+	[[nodiscard]] static auto get() -> ParkingLot& {
+		static auto ret = ParkingLot{};
+		return ret;
+	}
+
+	// the waiter must be registered before tasks are checked, and the count incremented after: pairs with is_anyone_parked().
+	void park(std::span<Task* const> tasks, Waiter& waiter) {
+		for (auto const* task : tasks) {
+			auto& bucket = get_bucket(task);
+			auto lock = std::scoped_lock{bucket.mutex};
+			bucket.records.push_back(Record{.task = task, .waiter = &waiter});
+		}
+		s_parked += tasks.size();
+	}
+
+	void unpark(std::span<Task* const> tasks, Waiter const& waiter) {
+		for (auto const* task : tasks) {
+			auto& bucket = get_bucket(task);
+			auto lock = std::scoped_lock{bucket.mutex};
+			std::erase_if(bucket.records, [&](Record const& r) { return r.task == task && r.waiter == &waiter; });
+		}
+		s_parked -= tasks.size();
+	}
+
+	[[nodiscard]] static auto is_anyone_parked() -> bool { return s_parked > 0; }
+
+	// task is not dereferenced: it may already have been destroyed.
+	void wake(Task const* task) {
+		auto& bucket = get_bucket(task);
+		auto lock = std::scoped_lock{bucket.mutex};
+		for (auto const& record : bucket.records) {
+			if (record.task != task) { continue; }
+			{
+				auto waiter_lock = std::scoped_lock{record.waiter->mutex};
+				record.waiter->woken = true;
+			}
+			record.waiter->cv.notify_one();
+		}
+	}
+
+  private:
+	static constexpr auto bucket_count_v = std::size_t{64};
+
+	struct Record {
+		Task const* task{};
+		Waiter* waiter{};
+	};
+
+	struct Bucket {
+		std::mutex mutex{};
+		std::vector<Record> records{};
+	};
+
+	[[nodiscard]] auto get_bucket(Task const* task) -> Bucket& {
+		return m_buckets.at((std::uintptr_t(task) / alignof(std::max_align_t)) % bucket_count_v);
+	}
+
+	inline static std::atomic<std::size_t> s_parked{}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+	std::array<Bucket, bucket_count_v> m_buckets{};
+};
+
+[[nodiscard]] auto find_idle(std::span<Task* const> tasks) -> Task* {
+	auto const it = std::ranges::find_if(tasks, [](Task const* t) { return !t->is_busy(); });
+	return it == tasks.end() ? nullptr : *it;
+}
+
+// no deadline: waits indefinitely.
+[[nodiscard]] auto wait_idle(std::span<Task* const> tasks, std::optional<chr::steady_clock::time_point> const deadline) -> Task* {
+	if (tasks.empty()) { return nullptr; }
+	if (auto* ret = find_idle(tasks)) { return ret; }
+	auto& parking_lot = ParkingLot::get();
+	auto waiter = ParkingLot::Waiter{};
+	parking_lot.park(tasks, waiter);
+	auto* ret = find_idle(tasks);
+	while (ret == nullptr) {
+		auto lock = std::unique_lock{waiter.mutex};
+		auto const woken = [&waiter] { return waiter.woken; };
+		if (!deadline) {
+			waiter.cv.wait(lock, woken);
+		} else if (!waiter.cv.wait_until(lock, *deadline, woken)) {
+			break;
+		}
+		waiter.woken = false;
+		lock.unlock();
+		// the woken Task may already have been re-enqueued.
+		ret = find_idle(tasks);
+	}
+	parking_lot.unpark(tasks, waiter);
+	return ret;
+}
+} // namespace
+
+struct ThreadPool::Impl : Pool {
+	using Pool::Pool;
+};
+
+auto Histogram::upper_bound(std::size_t const bucket) -> chr::nanoseconds {
+	if (bucket == 0) { return {}; }
+	return chr::nanoseconds{std::int64_t{1} << std::min(bucket, bucket_count_v - 1)};
+}
+
+auto Histogram::percentile(double const pct) const -> chr::nanoseconds {
+	if (count == 0) { return {}; }
+	auto const target = std::uint64_t(std::clamp(pct, 0.0, 100.0) * double(count - 1) / 100.0);
+	auto seen = std::uint64_t{};
+	for (auto i = std::size_t{}; i < buckets.size(); ++i) {
+		seen += buckets.at(i);
+		if (seen > target) { return upper_bound(i); }
+	}
+	return upper_bound(bucket_count_v - 1);
+}
+
+auto Histogram::operator+=(Histogram const& rhs) -> Histogram& {
+	for (auto i = std::size_t{}; i < buckets.size(); ++i) { buckets.at(i) += rhs.buckets.at(i); }
+	count += rhs.count;
+	return *this;
+}
+
+void Task::on_enqueued(void const* owner) {
+	on_reset();
+	m_owner = owner;
+	m_status = Status::Queued;
+	m_exception = {};
+	m_stop_requested = false;
+	m_busy = true;
+}
+
+auto Task::try_claim(void const* owner) -> bool {
+	auto expected = false;
+	if (!m_busy.compare_exchange_strong(expected, true)) { return false; }
+	on_enqueued(owner);
+	return true;
+}
+
 void Task::do_execute() {
-	m_status = Status::Executing;
+	auto expected = Status::Queued;
+	if (!m_status.compare_exchange_strong(expected, Status::Executing)) {
+		// cancelled while queued.
+		finalize();
+		return;
+	}
 	try {
 		execute();
-	} catch (...) {}
+	} catch (...) { m_exception = std::current_exception(); }
 	finalize();
 }
 
@@ -75,65 +1411,189 @@ void Task::finalize() {
 	case Status::Executing: m_status = Status::Completed; break;
 	default: break;
 	}
+	auto const status = m_status.load();
+	auto* observer = std::exchange(m_observer, nullptr);
 	m_busy = false;
 	m_busy.notify_all();
+	if (ParkingLot::is_anyone_parked()) { ParkingLot::get().wake(this); }
+	if (observer != nullptr) { observer->on_finalized(status); }
+}
+
+auto Task::wait_for(chr::nanoseconds const timeout) -> bool { return wait_until(chr::steady_clock::now() + timeout); }
+
+auto Task::wait_until(chr::steady_clock::time_point const deadline) -> bool {
+	if (!m_busy) { return true; }
+	auto const tasks = std::array{this};
+	return wait_idle(tasks, deadline) != nullptr;
 }
 
-struct Queue::Impl {
+auto wait_any(std::span<Task* const> tasks) -> Task* { return wait_idle(tasks, {}); }
+
+auto wait_any_for(std::span<Task* const> tasks, chr::nanoseconds const timeout) -> Task* { return wait_idle(tasks, chr::steady_clock::now() + timeout); }
+
+auto wait_any_until(std::span<Task* const> tasks, chr::steady_clock::time_point const deadline) -> Task* { return wait_idle(tasks, deadline); }
+
+struct Queue::Impl : PoolMember {
+	struct Batch {
+		std::span<Task* const> tasks{};
+		std::size_t next{};
+	};
+
 	Impl(Impl const&) = delete;
 	Impl(Impl&&) = delete;
 	auto operator=(Impl const&) = delete;
 	auto operator=(Impl&&) = delete;
 
-	explicit Impl(CreateInfo const& create_info) : m_create_info(create_info) { create_workers(); }
+	explicit Impl(CreateInfo const& create_info, Pool* pool)
+		: m_create_info(to_pooled(create_info, pool)), m_pool(pool),
+		  m_placements(pool != nullptr ? std::vector(pool->get_placements().begin(), pool->get_placements().end()) : place_workers(create_info)),
+		  m_backend(create_backend(m_create_info, m_placements)) {
+		m_create_info.affinity.cpus = {}; // copied into m_placements.
+		if (create_info.collect_stats) { m_stats = std::make_unique<StatsCollector>(max_threads()); }
+		if (m_pool != nullptr) {
+			m_active_threads = std::size_t(m_create_info.thread_count);
+			m_pool->attach(*this);
+			return;
+		}
+		create_workers();
+	}
 
-	~Impl() {
+	~Impl() override {
+		m_timer_thread = {};
+		if (m_pool != nullptr) {
+			detach();
+			return;
+		}
+		// Tasks finishing on workers may try to enqueue more (Strand turns, Graph successors): reject them.
+		m_draining = true;
 		drop_enqueued();
 		destroy_workers();
 	}
 
 	[[nodiscard]] auto thread_count() const -> ThreadCount { return m_create_info.thread_count; }
+	[[nodiscard]] auto active_thread_count() const -> ThreadCount { return ThreadCount(m_active_threads.load()); }
+	[[nodiscard]] auto worker_group_count() const -> std::size_t { return m_backend->group_count(); }
+	[[nodiscard]] auto max_elements() const -> ElementCount { return m_create_info.max_elements; }
 
-	[[nodiscard]] auto enqueued_count() const -> std::size_t {
-		auto lock = std::scoped_lock{m_mutex};
-		return m_queue.size();
-	}
+	[[nodiscard]] auto enqueued_count() const -> std::size_t { return m_count; }
 
 	[[nodiscard]] auto can_enqueue(std::size_t const count) const -> bool {
 		if (m_draining) { return false; }
 		if (m_create_info.max_elements == ElementCount::Unbounded) { return true; }
-		return enqueued_count() + count < std::size_t(m_create_info.max_elements);
+		return enqueued_count() + count <= std::size_t(m_create_info.max_elements);
 	}
 
-	auto enqueue(std::span<Task* const> tasks) -> bool {
+	// priority is only applied once the whole batch has been accepted.
+	auto enqueue(std::span<Task* const> tasks, std::optional<Priority> const priority = {}) -> bool {
 		if (tasks.empty()) { return true; }
-		if (!can_enqueue(tasks.size())) { return false; }
-		for (auto* task : tasks) {
-			assert(!task->is_busy());
-			if (task->m_id == Task::Id::None) { task->m_id = Task::Id{++m_prev_id}; }
-			task->m_status = Task::Status::Queued;
-			task->m_busy = true;
+		if (has_busy(tasks) || !reserve(tasks.size())) { return false; }
+		if (priority) {
+			for (auto* task : tasks) { task->m_priority = *priority; }
 		}
-		auto lock = std::unique_lock{m_mutex};
-		m_queue.insert(m_queue.end(), tasks.begin(), tasks.end());
-		lock.unlock();
-		if (tasks.size() > 1) {
-			m_work_cv.notify_all();
+		push(tasks);
+		return true;
+	}
+
+	// never overtakes producers blocked in enqueue_until().
+	auto try_enqueue(std::span<Task* const> tasks) -> bool {
+		if (m_space_waiter_count > 0) { return false; }
+		return enqueue(tasks);
+	}
+
+	// blocked producers are served in arrival order: each parks on its own condition variable and only the head is woken.
+	auto enqueue_until(std::span<Task* const> tasks, std::optional<chr::steady_clock::time_point> const deadline) -> bool {
+		if (tasks.empty()) { return true; }
+		if (m_create_info.max_elements != ElementCount::Unbounded && tasks.size() > std::size_t(m_create_info.max_elements)) { return false; }
+		if (has_busy(tasks)) { return false; }
+		if (try_enqueue(tasks)) { return true; }
+		auto waiter = SpaceWaiter{};
+		auto lock = std::unique_lock{m_space_mutex};
+		m_space_waiters.push_back(&waiter);
+		++m_space_waiter_count;
+		auto const ready = [&] { return m_space_waiters.front() == &waiter && reserve(tasks.size()); };
+		auto reserved = true;
+		if (deadline) {
+			reserved = waiter.cv.wait_until(lock, *deadline, ready);
 		} else {
-			m_work_cv.notify_one();
+			waiter.cv.wait(lock, ready);
 		}
+		std::erase(m_space_waiters, &waiter);
+		--m_space_waiter_count;
+		// pass the turn on: there may be space left over, or this waiter timed out at the head.
+		if (!m_space_waiters.empty()) { m_space_waiters.front()->cv.notify_one(); }
+		lock.unlock();
+		if (!reserved) { return false; }
+		push(tasks);
 		return true;
 	}
 
+	// tasks must have been reserved.
+	void push(std::span<Task* const> tasks) {
+		prepare(tasks);
+		if (m_stats) { m_stats->on_depth(m_count.load(std::memory_order_relaxed)); }
+		m_backend->push(tasks, get_worker_index());
+		wake(tasks.size());
+		if (is_elastic() && m_sleeping == 0 && m_spinning == 0 && m_count > m_create_info.elastic.depth_per_thread * m_active_threads) {
+			try_grow(ResizeReason::Depth);
+		}
+	}
+
+	// the batch is claimed by the caller and idle workers alike: the caller never blocks on a Task that has not started yet,
+	// which keeps nested fork_join calls (from within workers) deadlock free.
 	auto fork_join(std::span<Task* const> tasks) -> Task::Status {
 		if (tasks.empty()) { return Task::Status::None; }
-		if (!enqueue(tasks)) { return Task::Status::Dropped; }
-		auto const got_dropped = [](Task* task) {
-			task->wait();
-			return task->m_status == Task::Status::Dropped;
-		};
-		if (std::ranges::any_of(tasks, got_dropped)) { return Task::Status::Dropped; }
-		return Task::Status::Completed;
+		if (m_draining) { return Task::Status::Dropped; }
+		if (std::ranges::any_of(tasks, [](Task const* task) { return task->is_busy() || task->m_observer != nullptr; })) { return Task::Status::Dropped; }
+		auto group = Group{};
+		for (auto* task : tasks) { group.add(*task); }
+		prepare(tasks);
+		m_in_flight += tasks.size();
+		auto batch = Batch{.tasks = tasks};
+		push_batch(batch);
+		while (auto* task = claim(batch)) { execute(*task); }
+		group.wait();
+		return group.dropped_count() > 0 ? Task::Status::Dropped : Task::Status::Completed;
+	}
+
+	auto add_timer(Task& task, chr::steady_clock::time_point const time, chr::nanoseconds const period) -> TimerId {
+		auto lock = std::scoped_lock{m_timer_mutex};
+		if (!m_timer_thread.joinable()) {
+			m_timer_thread = std::jthread{[this](std::stop_token const& s) { timer_thunk(s); }};
+		}
+		if (m_timers.is_empty()) { m_timers.reset(to_tick(chr::steady_clock::now(), false)); }
+		auto const ticks = std::uint64_t((period + m_create_info.timer_resolution - chr::nanoseconds{1}) / m_create_info.timer_resolution);
+		auto const ret = m_timers.add(task, to_tick(time, true), ticks);
+		m_timer_cv.notify_one();
+		return ret;
+	}
+
+	auto cancel_timer(TimerId const id) -> bool {
+		auto lock = std::scoped_lock{m_timer_mutex};
+		return m_timers.cancel(id);
+	}
+
+	[[nodiscard]] auto timer_count() const -> std::size_t {
+		auto lock = std::scoped_lock{m_timer_mutex};
+		return m_timers.size();
+	}
+
+	[[nodiscard]] auto snapshot() const -> QueueStats {
+		if (!m_stats) { return {}; }
+		return m_stats->snapshot();
+	}
+
+	[[nodiscard]] auto resize_history() const -> std::vector<ResizeEvent> {
+		auto lock = std::scoped_lock{m_resize_mutex};
+		return {m_resize_history.begin(), m_resize_history.end()};
+	}
+
+	auto acquire_callable() -> detail::CallableTask* { return m_callables.acquire(); }
+
+	auto submit(detail::CallableTask& task) -> bool {
+		auto const tasks = std::array<Task*, 1>{&task};
+		if (enqueue(tasks)) { return true; }
+		m_callables.release(task);
+		return false;
 	}
 
 	void pause() { m_paused = true; }
@@ -141,78 +1601,386 @@ struct Queue::Impl {
 	void resume() {
 		if (!m_paused) { return; }
 		m_paused = false;
-		m_work_cv.notify_all();
+		wake_all();
 	}
 
+	// waits for executing tasks too, not just an empty backend: workers are left running.
 	void drain_and_wait() {
 		resume();
 		m_draining = true;
-		auto lock = std::unique_lock{m_mutex};
-		m_empty_cv.wait(lock, [this] { return m_queue.empty(); });
-		assert(m_queue.empty());
-		lock.unlock();
-		recreate_workers();
+		for (auto count = m_in_flight.load(); count > 0; count = m_in_flight.load()) { m_in_flight.wait(count); }
 		m_draining = false;
+		notify_space();
 	}
 
 	void drop_enqueued() {
-		auto lock = std::scoped_lock{m_mutex};
-		for (auto* task : m_queue) { task->do_drop(); }
-		m_queue.clear();
+		auto tasks = std::vector<Task*>{};
+		m_backend->pop_all(tasks);
+		if (tasks.empty()) { return; }
+		for (auto* task : tasks) { task->do_drop(); }
+		on_popped(tasks.size());
+		on_finished(tasks.size());
+	}
+
+  private:
+	// backends of pooled Queues are sized for the pool's workers.
+	[[nodiscard]] static auto to_pooled(CreateInfo create_info, Pool const* pool) -> CreateInfo {
+		create_info.weight = std::max(create_info.weight, std::uint32_t{1});
+		if (pool == nullptr) { return create_info; }
+		create_info.thread_count = pool->thread_count();
+		create_info.affinity = {};
+		create_info.elastic = {};
+		return create_info;
+	}
+
+	struct SpaceWaiter {
+		std::condition_variable_any cv{};
+	};
+
+	[[nodiscard]] auto max_threads() const -> std::size_t {
+		return std::max(std::size_t(m_create_info.elastic.max_threads), std::size_t(m_create_info.thread_count));
+	}
+
+	[[nodiscard]] auto is_elastic() const -> bool { return max_threads() > std::size_t(m_create_info.thread_count); }
+
+	// slots beyond thread_count are only started in elastic mode.
+	void create_workers() {
+		m_threads.resize(max_threads());
+		m_running = std::vector<std::atomic_bool>(m_threads.size());
+		for (auto index = std::size_t{}; index < std::size_t(m_create_info.thread_count); ++index) { start_worker(index); }
+	}
+
+	void start_worker(std::size_t const index) {
+		m_running[index] = true;
+		++m_active_threads;
+		if (m_stats) { m_stats->on_worker_started(); }
+		m_threads[index] = std::jthread{[this, index](std::stop_token const& s) { thunk(s, index); }};
+	}
+
+	// enqueues are rejected while tasks still executing on pool workers are waited for, the Pool keeps this pinned until they return.
+	void detach() {
+		m_draining = true;
+		m_pool->detach(*this);
+		drop_enqueued();
+		for (auto count = m_in_flight.load(); count > 0; count = m_in_flight.load()) { m_in_flight.wait(count); }
+	}
+
+	void destroy_workers() {
+		{
+			auto lock = std::scoped_lock{m_resize_mutex};
+			m_stopping = true;
+			for (auto& thread : m_threads) { thread.request_stop(); }
+		}
+		wake_all();
+		m_threads.clear();
+	}
+
+	// m_resize_mutex must be locked.
+	void push_resize_event(ResizeReason const reason) {
+		static constexpr auto max_history_v = std::size_t{64};
+		if (m_resize_history.size() == max_history_v) { m_resize_history.pop_front(); }
+		m_resize_history.push_back(ResizeEvent{.time = chr::steady_clock::now(), .thread_count = active_thread_count(), .reason = reason});
+	}
+
+	void try_grow(ResizeReason const reason) {
+		if (m_active_threads >= max_threads()) { return; }
+		auto lock = std::unique_lock{m_resize_mutex, std::try_to_lock};
+		if (!lock.owns_lock() || m_stopping) { return; }
+		for (auto index = std::size_t(m_create_info.thread_count); index < m_threads.size(); ++index) {
+			if (m_running[index]) { continue; }
+			// a retired worker's thread has already returned (or is about to): joins immediately.
+			if (m_threads[index].joinable()) { m_threads[index].join(); }
+			start_worker(index);
+			push_resize_event(reason);
+			return;
+		}
+	}
+
+	void retire(std::stop_token const& s, std::size_t const index) {
+		auto lock = std::scoped_lock{m_resize_mutex};
+		--m_active_threads;
+		if (!s.stop_requested()) { push_resize_event(ResizeReason::Idle); }
+		m_running[index] = false;
+	}
+
+	[[nodiscard]] static auto has_busy(std::span<Task* const> tasks) -> bool {
+		return std::ranges::any_of(tasks, [](Task const* task) { return task->is_busy(); });
+	}
+
+	// bounds check and insertion into m_count are a single atomic operation.
+	[[nodiscard]] auto reserve(std::size_t const count) -> bool {
+		if (m_draining) { return false; }
+		if (m_create_info.max_elements == ElementCount::Unbounded) {
+			m_count += count;
+		} else {
+			auto const max_elements = std::size_t(m_create_info.max_elements);
+			auto current = m_count.load();
+			do {
+				if (current + count > max_elements) { return false; }
+			} while (!m_count.compare_exchange_weak(current, current + count));
+		}
+		m_in_flight += count;
+		return true;
+	}
+
+	void prepare(std::span<Task* const> tasks) {
+		auto const enqueued_at = m_stats || is_elastic() ? StatsCollector::now() : std::int64_t{};
+		for (auto* task : tasks) {
+			task->m_enqueued_at = enqueued_at;
+			assert(!task->is_busy());
+			if (task->m_id == Task::Id::None) { task->m_id = Task::Id{++m_prev_id}; }
+			task->on_enqueued(this);
+		}
+	}
+
+	void push_batch(Batch& batch) {
+		auto lock = std::unique_lock{m_batch_mutex};
+		m_batches.push_back(&batch);
+		m_batched += batch.tasks.size();
+		lock.unlock();
+		wake(batch.tasks.size());
+	}
+
+	// m_batch_mutex must be locked.
+	[[nodiscard]] auto claim_locked(Batch& batch) -> Task* {
+		if (batch.next == batch.tasks.size()) { return nullptr; }
+		auto* ret = batch.tasks[batch.next++];
+		if (batch.next == batch.tasks.size()) { std::erase(m_batches, &batch); }
+		--m_batched;
+		return ret;
+	}
+
+	[[nodiscard]] auto claim(Batch& batch) -> Task* {
+		auto lock = std::scoped_lock{m_batch_mutex};
+		return claim_locked(batch);
+	}
+
+	// the most recent batch is claimed first, which favours inner (nested) fork_joins.
+	[[nodiscard]] auto claim_any() -> Task* {
+		if (m_batched == 0) { return nullptr; }
+		auto lock = std::scoped_lock{m_batch_mutex};
+		if (m_batches.empty()) { return nullptr; }
+		return claim_locked(*m_batches.back());
+	}
+
+	[[nodiscard]] auto get_worker_index() const -> std::size_t { return t_worker.owner == this ? t_worker.index : no_worker_v; }
+
+	void wake(std::size_t const count) {
+		if (m_pool != nullptr) {
+			m_pool->wake(count);
+			return;
+		}
+		if (m_sleeping == 0) { return; }
+		{ auto lock = std::scoped_lock{m_sleep_mutex}; }
+		if (count > 1) {
+			m_work_cv.notify_all();
+		} else {
+			m_work_cv.notify_one();
+		}
+	}
+
+	void wake_all() {
+		if (m_pool != nullptr) {
+			m_pool->wake_all();
+			return;
+		}
+		{ auto lock = std::scoped_lock{m_sleep_mutex}; }
+		m_work_cv.notify_all();
+	}
+
+	// the decrement of m_count and the load of m_space_waiter_count pair with their reverse order in enqueue_until().
+	void on_popped(std::size_t const count) {
+		m_count -= count;
+		if (m_space_waiter_count > 0) { notify_space(); }
+	}
+
+	void notify_space() {
+		auto lock = std::scoped_lock{m_space_mutex};
+		if (!m_space_waiters.empty()) { m_space_waiters.front()->cv.notify_one(); }
+	}
+
+	void on_finished(std::size_t const count) {
+		if (m_in_flight.fetch_sub(count) == count) { m_in_flight.notify_all(); }
+	}
+
+	// the task must not be accessed after do_execute(): it may have been destroyed or re-enqueued.
+	void execute(Task& task) {
+		if (m_stats) {
+			execute(task, m_stats->get_counters(get_worker_index()), StatsCollector::now());
+			return;
+		}
+		task.do_execute();
+		on_finished(1);
+	}
+
+	// returns the time at which execution finished.
+	auto execute(Task& task, StatsCollector::Counters& counters, std::int64_t const start) -> std::int64_t {
+		StatsCollector::record(counters.start_latency, start - task.m_enqueued_at);
+		task.do_execute();
+		auto const end = StatsCollector::now();
+		StatsCollector::record(counters.execute_duration, end - start);
+		StatsCollector::add(counters.busy_ns, end - start);
+		counters.executed.fetch_add(1, std::memory_order_relaxed);
+		on_finished(1);
+		return end;
+	}
+
+	[[nodiscard]] auto has_work() const -> bool final { return !m_paused && (m_count > 0 || m_batched > 0); }
+
+	[[nodiscard]] auto get_weight() const -> std::uint32_t final { return m_create_info.weight; }
+
+	[[nodiscard]] auto try_pop(std::size_t const worker) -> Task* final {
+		if (m_paused) { return nullptr; }
+		if (auto* task = claim_any()) { return task; }
+		auto* ret = m_backend->pop(worker);
+		if (ret != nullptr) { on_popped(1); }
+		return ret;
+	}
+
+	void execute_on(Task& task, std::size_t const worker) final {
+		t_worker = WorkerContext{.owner = this, .index = worker};
+		execute(task);
+		t_worker = {};
 	}
 
-  private:
-	void create_workers() {
-		auto const count = std::size_t(m_create_info.thread_count);
-		m_threads.reserve(count);
-		while (m_threads.size() < count) {
-			m_threads.emplace_back([this](std::stop_token const& s) { thunk(s); });
+	// workers that are not parked are never notified. Spinning ones are counted as idle: elastic growth leaves the backlog to them.
+	[[nodiscard]] auto await_work(std::stop_token const& s) -> bool {
+		if (m_create_info.idle_policy.mode == IdleMode::Park) { return false; }
+		++m_spinning;
+		auto const ret = await_ready(m_create_info.idle_policy, [&] { return s.stop_requested() || has_work(); });
+		--m_spinning;
+		return ret;
+	}
+
+	[[nodiscard]] auto next_task(std::stop_token const& s, std::size_t const index) -> Task* {
+		while (!s.stop_requested()) {
+			if (auto* task = try_pop(index)) { return task; }
+			if (await_work(s)) { continue; }
+			auto lock = std::unique_lock{m_sleep_mutex};
+			++m_sleeping;
+			auto const woken = index < std::size_t(m_create_info.thread_count)
+								   ? m_work_cv.wait(lock, s, [this] { return has_work(); })
+								   : m_work_cv.wait_for(lock, s, m_create_info.elastic.idle_timeout, [this] { return has_work(); });
+			--m_sleeping;
+			// elastic workers retire on timeout.
+			if (!woken) { return nullptr; }
 		}
+		return nullptr;
 	}
 
-	void destroy_workers() {
-		for (auto& thread : m_threads) { thread.request_stop(); }
-		m_work_cv.notify_all();
-		m_threads.clear();
+	// expiries are rounded up and the current time is rounded down: a timer never fires early.
+	[[nodiscard]] auto to_tick(chr::steady_clock::time_point const time, bool const round_up) const -> std::uint64_t {
+		auto elapsed = std::max(chr::duration_cast<chr::nanoseconds>(time - m_timer_epoch), chr::nanoseconds{});
+		auto const& resolution = m_create_info.timer_resolution;
+		if (round_up) { elapsed += resolution - chr::nanoseconds{1}; }
+		return std::uint64_t(elapsed / resolution);
 	}
 
-	void recreate_workers() {
-		destroy_workers();
-		create_workers();
+	[[nodiscard]] auto to_time(std::uint64_t const tick) const -> chr::steady_clock::time_point {
+		return m_timer_epoch + chr::duration_cast<chr::steady_clock::duration>(m_create_info.timer_resolution * tick);
 	}
 
-	void thunk(std::stop_token const& s) {
+	// sleeps until the wheel's next non-empty tick (or an earlier timer is added) while timers are pending, until a timer is added otherwise.
+	void timer_thunk(std::stop_token const& s) {
+		auto const enqueue_task = [this](Task& task) {
+			if (task.is_busy()) { return false; }
+			auto const tasks = std::array{&task};
+			return enqueue(tasks);
+		};
+		auto lock = std::unique_lock{m_timer_mutex};
 		while (!s.stop_requested()) {
-			auto lock = std::unique_lock{m_mutex};
-			if (!m_work_cv.wait(lock, s, [this] { return !m_paused && !m_queue.empty(); })) { return; }
-			if (s.stop_requested()) { return; }
-			auto* task = m_queue.front();
-			m_queue.pop_front();
-			auto const observed_empty = m_queue.empty();
-			lock.unlock();
-			task->do_execute();
-			if (observed_empty) { m_empty_cv.notify_one(); }
+			if (m_timers.is_empty()) {
+				m_timer_cv.wait(lock, s, [this] { return !m_timers.is_empty(); });
+				continue;
+			}
+			auto const next = m_timers.next_tick();
+			if (!m_timer_cv.wait_until(lock, s, to_time(next), [this, next] { return m_timers.next_tick() < next; })) {
+				// idle ticks are skipped instead of advanced one by one.
+				auto const now = to_tick(chr::steady_clock::now(), false);
+				for (m_timers.skip_to(now); !m_timers.is_empty() && m_timers.current_tick() <= now; m_timers.skip_to(now)) { m_timers.advance(enqueue_task); }
+			}
+		}
+	}
+
+	void thunk(std::stop_token const& s, std::size_t const index) {
+		t_worker = WorkerContext{.owner = this, .index = index};
+		if (index < m_placements.size()) { pin_current_thread(m_placements[index].cpus); }
+		run(s, index);
+		if (index >= std::size_t(m_create_info.thread_count)) { retire(s, index); }
+	}
+
+	void run(std::stop_token const& s, std::size_t const index) {
+		if (!m_stats) {
+			while (auto* task = next_task(s, index)) {
+				check_wait_time(*task);
+				execute(*task);
+			}
+			return;
 		}
+		auto& counters = m_stats->get_counters(index);
+		auto idle_since = StatsCollector::now();
+		while (auto* task = next_task(s, index)) {
+			auto const start = StatsCollector::now();
+			check_wait_time(*task);
+			StatsCollector::add(counters.idle_ns, start - idle_since);
+			idle_since = execute(*task, counters, start);
+		}
+	}
+
+	void check_wait_time(Task const& task) {
+		if (!is_elastic()) { return; }
+		auto const wait_time = chr::nanoseconds{StatsCollector::now() - task.m_enqueued_at};
+		if (wait_time > m_create_info.elastic.wait_threshold) { try_grow(ResizeReason::WaitTime); }
 	}
 
 	CreateInfo m_create_info{};
-	mutable std::mutex m_mutex{};
+	Pool* m_pool{};
+	std::vector<WorkerPlacement> m_placements{};
+	std::unique_ptr<Backend> m_backend{};
+	std::unique_ptr<StatsCollector> m_stats{};
+
+	std::atomic<std::size_t> m_count{};
+	// enqueued + executing.
+	std::atomic<std::size_t> m_in_flight{};
+	std::atomic<std::size_t> m_sleeping{};
+	std::atomic<std::size_t> m_spinning{};
+	std::mutex m_sleep_mutex{};
 	std::condition_variable_any m_work_cv{};
-	std::condition_variable m_empty_cv{};
 	std::atomic_bool m_paused{};
 	std::atomic_bool m_draining{};
 
-	std::deque<Task*> m_queue{};
-	std::vector<std::jthread> m_threads{};
+	std::mutex m_space_mutex{};
+	std::deque<SpaceWaiter*> m_space_waiters{};
+	std::atomic<std::size_t> m_space_waiter_count{};
+
+	std::mutex m_batch_mutex{};
+	std::vector<Batch*> m_batches{};
+	std::atomic<std::size_t> m_batched{};
 
-	std::underlying_type_t<Task::Id> m_prev_id{};
+	detail::CallablePool m_callables{};
+
+	std::vector<std::jthread> m_threads{};
+	std::vector<std::atomic_bool> m_running{};
+	std::atomic<std::size_t> m_active_threads{};
+	mutable std::mutex m_resize_mutex{};
+	std::deque<ResizeEvent> m_resize_history{};
+	bool m_stopping{};
+
+	mutable std::mutex m_timer_mutex{};
+	std::condition_variable_any m_timer_cv{};
+	TimerWheel m_timers{};
+	chr::steady_clock::time_point m_timer_epoch{chr::steady_clock::now()};
+	std::jthread m_timer_thread{};
+
+	std::atomic<std::underlying_type_t<Task::Id>> m_prev_id{};
 };
 
 void Queue::Deleter::operator()(Impl* ptr) const noexcept { std::default_delete<Impl>{}(ptr); }
 
 Queue::Queue(CreateInfo create_info) {
 	create_info.thread_count = std::clamp(create_info.thread_count, ThreadCount::Minimum, get_max_threads());
-	m_impl.reset(new Impl(create_info)); // NOLINT(cppcoreguidelines-owning-memory)
+	auto* pool = create_info.pool != nullptr ? static_cast<Pool*>(create_info.pool->m_impl.get()) : nullptr;
+	m_impl.reset(new Impl(create_info, pool)); // NOLINT(cppcoreguidelines-owning-memory)
 }
 
 auto Queue::thread_count() const -> ThreadCount {
@@ -220,6 +1988,21 @@ auto Queue::thread_count() const -> ThreadCount {
 	return m_impl->thread_count();
 }
 
+auto Queue::active_thread_count() const -> ThreadCount {
+	if (!m_impl) { return ThreadCount{0}; }
+	return m_impl->active_thread_count();
+}
+
+auto Queue::worker_group_count() const -> std::size_t {
+	if (!m_impl) { return 0; }
+	return m_impl->worker_group_count();
+}
+
+auto Queue::max_elements() const -> ElementCount {
+	if (!m_impl) { return ElementCount::Unbounded; }
+	return m_impl->max_elements();
+}
+
 auto Queue::enqueued_count() const -> std::size_t {
 	if (!m_impl) { return 0; }
 	return m_impl->enqueued_count();
@@ -240,11 +2023,99 @@ auto Queue::enqueue(std::span<Task* const> tasks) -> bool {
 	return m_impl->enqueue(tasks);
 }
 
+auto Queue::enqueue(Task& task, Priority const priority) -> bool {
+	auto const tasks = std::array{&task};
+	return enqueue(tasks, priority);
+}
+
+auto Queue::enqueue(std::span<Task* const> tasks, Priority const priority) -> bool {
+	if (!m_impl) { return false; }
+	return m_impl->enqueue(tasks, priority);
+}
+
+auto Queue::try_enqueue(Task& task) -> bool {
+	auto const tasks = std::array{&task};
+	return try_enqueue(tasks);
+}
+
+auto Queue::try_enqueue(std::span<Task* const> tasks) -> bool {
+	if (!m_impl) { return false; }
+	return m_impl->try_enqueue(tasks);
+}
+
+auto Queue::enqueue_wait(Task& task) -> bool {
+	auto const tasks = std::array{&task};
+	return enqueue_wait(tasks);
+}
+
+auto Queue::enqueue_wait(std::span<Task* const> tasks) -> bool {
+	if (!m_impl) { return false; }
+	return m_impl->enqueue_until(tasks, {});
+}
+
+auto Queue::enqueue_for(Task& task, chr::nanoseconds const timeout) -> bool {
+	auto const tasks = std::array{&task};
+	return enqueue_for(tasks, timeout);
+}
+
+auto Queue::enqueue_for(std::span<Task* const> tasks, chr::nanoseconds const timeout) -> bool {
+	if (!m_impl) { return false; }
+	return m_impl->enqueue_until(tasks, chr::steady_clock::now() + timeout);
+}
+
 auto Queue::fork_join(std::span<Task* const> tasks) -> Task::Status {
 	if (!m_impl) { return Task::Status::None; }
 	return m_impl->fork_join(tasks);
 }
 
+auto Queue::enqueue_at(Task& task, chr::steady_clock::time_point const time) -> TimerId {
+	if (!m_impl) { return TimerId::None; }
+	return m_impl->add_timer(task, time, {});
+}
+
+auto Queue::enqueue_after(Task& task, chr::nanoseconds const delay) -> TimerId { return enqueue_at(task, chr::steady_clock::now() + delay); }
+
+auto Queue::enqueue_every(Task& task, chr::nanoseconds const period) -> TimerId {
+	if (!m_impl || period <= chr::nanoseconds{}) { return TimerId::None; }
+	return m_impl->add_timer(task, chr::steady_clock::now() + period, period);
+}
+
+auto Queue::cancel_timer(TimerId const id) -> bool {
+	if (!m_impl) { return false; }
+	return m_impl->cancel_timer(id);
+}
+
+auto Queue::timer_count() const -> std::size_t {
+	if (!m_impl) { return 0; }
+	return m_impl->timer_count();
+}
+
+auto Queue::acquire_callable() -> detail::CallableTask* {
+	if (!m_impl) { return nullptr; }
+	return m_impl->acquire_callable();
+}
+
+auto Queue::submit(detail::CallableTask& task) -> bool { return m_impl->submit(task); }
+
+auto Queue::cancel(Task& task) -> bool {
+	// a Task owned by another executor may still be linked there: leave it alone.
+	auto const* owner = task.m_owner.load();
+	if (!m_impl || (owner != m_impl.get() && owner != this)) { return false; }
+	task.request_stop();
+	auto expected = Task::Status::Queued;
+	return task.m_status.compare_exchange_strong(expected, Task::Status::Dropped);
+}
+
+auto Queue::snapshot() const -> QueueStats {
+	if (!m_impl) { return {}; }
+	return m_impl->snapshot();
+}
+
+auto Queue::resize_history() const -> std::vector<ResizeEvent> {
+	if (!m_impl) { return {}; }
+	return m_impl->resize_history();
+}
+
 void Queue::pause() {
 	if (!m_impl) { return; }
 	m_impl->pause();
@@ -264,9 +2135,486 @@ void Queue::drop_enqueued() {
 	if (!m_impl) { return; }
 	m_impl->drop_enqueued();
 }
+
+void ThreadPool::Deleter::operator()(Impl* ptr) const noexcept { std::default_delete<Impl>{}(ptr); }
+
+ThreadPool::ThreadPool(CreateInfo create_info) {
+	create_info.thread_count = std::clamp(create_info.thread_count, ThreadCount::Minimum, get_max_threads());
+	m_impl.reset(new Impl(create_info)); // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+auto ThreadPool::thread_count() const -> ThreadCount {
+	if (!m_impl) { return ThreadCount{0}; }
+	return m_impl->thread_count();
+}
+
+auto ThreadPool::queue_count() const -> std::size_t {
+	if (!m_impl) { return 0; }
+	return m_impl->member_count();
+}
+
+auto Schedule::resume_on(Queue& queue, std::coroutine_handle<> const handle) -> bool {
+	m_resumer.handle = handle;
+	m_observer = &m_resumer;
+	if (queue.enqueue(*this)) { return true; }
+	m_observer = nullptr;
+	return false;
+}
+
+// the coroutine may destroy this Schedule: nothing touches it after resume().
+void Schedule::Resumer::on_finalized(Status const /*status*/) { std::coroutine_handle<>{handle}.resume(); }
+
+Group::~Group() {
+	wait();
+	// on_finalized() may still be notifying after the last decrement of m_pending.
+	m_in_callback.wait_idle();
+}
+
+// a Task has a single observer slot: overwriting it would silently detach the Task from its current owner.
+auto Group::add(Task& task) -> bool {
+	if (task.is_busy() || task.m_observer != nullptr) { return false; }
+	++m_pending;
+	task.m_observer = &m_tracker;
+	return true;
+}
+
+auto Group::enqueue(Queue& queue, Task& task) -> bool {
+	auto const tasks = std::array{&task};
+	return enqueue(queue, tasks);
+}
+
+auto Group::enqueue(Queue& queue, std::span<Task* const> tasks) -> bool {
+	for (auto i = std::size_t{}; i < tasks.size(); ++i) {
+		if (add(*tasks[i])) { continue; }
+		remove(tasks.first(i));
+		return false;
+	}
+	if (queue.enqueue(tasks)) { return true; }
+	remove(tasks);
+	return false;
+}
+
+void Group::wait() {
+	if (m_pending == 0) { return; }
+	auto lock = std::unique_lock{m_mutex};
+	m_cv.wait(lock, [this] { return m_pending == 0; });
+}
+
+auto Group::wait_for(chr::nanoseconds const timeout) -> bool {
+	if (m_pending == 0) { return true; }
+	auto lock = std::unique_lock{m_mutex};
+	return m_cv.wait_for(lock, timeout, [this] { return m_pending == 0; });
+}
+
+auto Group::wait_any() -> bool {
+	auto lock = std::unique_lock{m_mutex};
+	// registered before the predicate is checked: a concurrent on_finalized() either sees the waiter, or is seen by it.
+	++m_any_waiters;
+	m_cv.wait(lock, [this] { return m_finished > m_consumed || m_pending == 0; });
+	--m_any_waiters;
+	if (m_finished == m_consumed) { return false; }
+	++m_consumed;
+	return true;
+}
+
+void Group::remove(std::span<Task* const> tasks) {
+	for (auto* task : tasks) { task->m_observer = nullptr; }
+	if (m_pending.fetch_sub(tasks.size()) == tasks.size()) { notify(); }
+}
+
+void Group::notify() {
+	{ auto lock = std::scoped_lock{m_mutex}; }
+	m_cv.notify_all();
+}
+
+void Group::Tracker::on_finalized(Status const status) { group->on_finalized(status); }
+
+void Group::on_finalized(Status const status) {
+	m_in_callback.enter();
+	if (status == Status::Dropped) { ++m_dropped; }
+	++m_finished;
+	// only the last Task wakes wait() / wait_for(), every Task wakes wait_any() waiters.
+	if (m_pending.fetch_sub(1) == 1 || m_any_waiters > 0) { notify(); }
+	m_in_callback.leave();
+}
+
+namespace {
+// Tasks run per turn of a Strand, before its worker is yielded to other work.
+constexpr auto strand_budget_v = std::size_t{32};
+} // namespace
+
+Strand::~Strand() {
+	wait();
+	m_in_callback.wait_idle();
+}
+
+void Strand::enqueue(Task& task) {
+	assert(!task.is_busy());
+	// cancellable through the Queue this Strand runs on.
+	task.on_enqueued(m_queue);
+	auto head = m_stack.load(std::memory_order_relaxed);
+	do { task.m_next = head; } while (!m_stack.compare_exchange_weak(head, &task, std::memory_order_release, std::memory_order_relaxed));
+	if (m_pending.fetch_add(1) == 0) { schedule(); }
+}
+
+void Strand::wait() {
+	for (auto count = m_pending.load(); count > 0; count = m_pending.load()) { m_pending.wait(count); }
+}
+
+void Strand::Runner::execute() { strand->run(strand_budget_v); }
+
+void Strand::Runner::on_finalized(Status const status) { strand->on_turn_end(status); }
+
+// m_pending > 0 and m_runner is not busy.
+void Strand::schedule() {
+	m_in_callback.enter();
+	while (true) {
+		m_runner.m_observer = &m_runner;
+		if (m_queue->enqueue(m_runner)) { break; }
+		m_runner.m_observer = nullptr;
+		// full / draining: run a turn inline, then offer the rest to the Queue again. Accepted Tasks are never dropped here.
+		run(strand_budget_v);
+		if (m_pending.fetch_sub(1) == 1) {
+			m_pending.notify_all();
+			break;
+		}
+	}
+	m_in_callback.leave();
+}
+
+// m_pending keeps counting the last Task run here: the turn ends (and m_pending may reach zero) only once m_runner is no longer busy.
+void Strand::run(std::size_t budget) {
+	while (true) {
+		pop()->do_execute();
+		if (--budget == 0 || m_pending.load() == 1) { return; }
+		--m_pending;
+	}
+}
+
+void Strand::on_turn_end(Status const status) {
+	m_in_callback.enter();
+	if (status == Status::Dropped) {
+		// the Queue is dropping its Tasks (drop_enqueued / destruction): a re-enqueued turn might never run.
+		pop()->do_drop();
+		drop_pending();
+	} else if (m_pending.fetch_sub(1) > 1) {
+		schedule();
+	} else {
+		m_pending.notify_all();
+	}
+	m_in_callback.leave();
+}
+
+// m_pending still counts the last Task run (or dropped) by the current turn.
+void Strand::drop_pending() {
+	while (m_pending.fetch_sub(1) > 1) { pop()->do_drop(); }
+	m_pending.notify_all();
+}
+
+// takes the whole stack once the FIFO has run dry: only ever called by the current turn.
+auto Strand::pop() -> Task* {
+	if (m_head == nullptr) {
+		auto* task = m_stack.exchange(nullptr, std::memory_order_acquire);
+		while (task != nullptr) {
+			auto* next = task->m_next;
+			task->m_next = m_head;
+			m_head = task;
+			task = next;
+		}
+	}
+	auto* ret = m_head;
+	m_head = ret->m_next;
+	return ret;
+}
+
+Notifier::~Notifier() {
+	wait();
+	m_in_callback.wait_idle();
+}
+
+void Notifier::notify() {
+	if (m_pending.fetch_add(1) == 0) { schedule(); }
+}
+
+void Notifier::wait() {
+	for (auto count = m_pending.load(); count > 0; count = m_pending.load()) { m_pending.wait(count); }
+}
+
+void Notifier::Tracker::on_finalized(Status const /*status*/) { notifier->on_run_end(); }
+
+// m_pending > 0 and m_task is not busy: the run handles all notifications counted so far.
+void Notifier::schedule() {
+	m_claimed = m_pending.load();
+	m_task->m_observer = &m_tracker;
+	if (m_queue->enqueue(*m_task)) { return; }
+	m_task->m_observer = nullptr;
+	m_in_callback.enter();
+	while (true) {
+		m_task->on_enqueued(nullptr);
+		m_task->do_execute();
+		if (!release_claim()) { break; }
+		m_claimed = m_pending.load();
+	}
+	m_in_callback.leave();
+}
+
+void Notifier::on_run_end() {
+	m_in_callback.enter();
+	if (release_claim()) { schedule(); }
+	m_in_callback.leave();
+}
+
+// returns true if notifications arrived after the current run was scheduled.
+auto Notifier::release_claim() -> bool {
+	// m_claimed may be overwritten by a notify() as soon as m_pending drops to zero.
+	auto const claimed = m_claimed;
+	if (m_pending.fetch_sub(claimed) > claimed) { return true; }
+	m_pending.notify_all();
+	return false;
+}
+
+// producers push onto m_stack, pump() moves it to the back of the FIFO it consumes from: only the owner thread touches m_head / m_tail.
+struct Dispatcher::Impl {
+	Impl(Impl const&) = delete;
+	Impl(Impl&&) = delete;
+	auto operator=(Impl const&) = delete;
+	auto operator=(Impl&&) = delete;
+
+	explicit Impl(std::thread::id const owner) : m_owner(owner) {}
+
+	~Impl() { drop_enqueued(); }
+
+	auto enqueue(Task& task) -> bool {
+		// linking a Task still queued elsewhere (or claimed by another producer) would corrupt both lists.
+		if (!task.try_claim(this)) { return false; }
+		++m_pending;
+		auto head = m_stack.load(std::memory_order_relaxed);
+		do { task.m_next = head; } while (!m_stack.compare_exchange_weak(head, &task, std::memory_order_release, std::memory_order_relaxed));
+		return true;
+	}
+
+	// tasks are not accessed after do_execute(): they may have been destroyed or re-enqueued.
+	auto pump(PumpBudget const& budget) -> std::size_t {
+		splice();
+		auto const start = chr::steady_clock::now();
+		auto ret = std::size_t{};
+		while (auto* task = pop()) {
+			task->do_execute();
+			++ret;
+			if (ret == budget.max_tasks) { break; }
+			if (budget.max_duration > chr::nanoseconds{} && chr::steady_clock::now() - start >= budget.max_duration) { break; }
+		}
+		return ret;
+	}
+
+	void drop_enqueued() {
+		splice();
+		while (auto* task = pop()) { task->do_drop(); }
+	}
+
+	// appends the stack (reversed) to the FIFO.
+	void splice() {
+		auto* task = m_stack.exchange(nullptr, std::memory_order_acquire);
+		if (task == nullptr) { return; }
+		auto* const last = task;
+		auto* first = static_cast<Task*>(nullptr);
+		while (task != nullptr) {
+			auto* next = task->m_next;
+			task->m_next = first;
+			first = task;
+			task = next;
+		}
+		if (m_tail == nullptr) {
+			m_head = first;
+		} else {
+			m_tail->m_next = first;
+		}
+		m_tail = last;
+	}
+
+	[[nodiscard]] auto pop() -> Task* {
+		if (m_head == nullptr) { return nullptr; }
+		auto* ret = std::exchange(m_head, m_head->m_next);
+		if (m_head == nullptr) { m_tail = nullptr; }
+		ret->m_next = nullptr;
+		--m_pending;
+		return ret;
+	}
+
+	std::thread::id m_owner;
+	detail::CallablePool m_callables{};
+	std::atomic<Task*> m_stack{};
+	std::atomic<std::size_t> m_pending{};
+	Task* m_head{};
+	Task* m_tail{};
+};
+
+void Dispatcher::Deleter::operator()(Impl* ptr) const noexcept { std::default_delete<Impl>{}(ptr); }
+
+Dispatcher::Dispatcher(std::thread::id const owner) {
+	m_impl.reset(new Impl(owner)); // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+auto Dispatcher::get_owner() const -> std::thread::id {
+	if (!m_impl) { return {}; }
+	return m_impl->m_owner;
+}
+
+auto Dispatcher::pending_count() const -> std::size_t {
+	if (!m_impl) { return 0; }
+	return m_impl->m_pending;
+}
+
+auto Dispatcher::enqueue(Task& task) -> bool {
+	if (!m_impl) { return false; }
+	return m_impl->enqueue(task);
+}
+
+auto Dispatcher::pump(PumpBudget const& budget) -> std::size_t {
+	if (!m_impl) { return 0; }
+	assert(is_owner_thread());
+	return m_impl->pump(budget);
+}
+
+void Dispatcher::drop_enqueued() {
+	if (!m_impl) { return; }
+	assert(is_owner_thread());
+	m_impl->drop_enqueued();
+}
+
+auto Dispatcher::acquire_callable() -> detail::CallableTask* {
+	if (!m_impl) { return nullptr; }
+	return m_impl->m_callables.acquire();
+}
+
+void Graph::Node::on_finalized(Status const status) { graph->on_finalized(*this, status); }
+
+Graph::~Graph() {
+	wait();
+	// on_finalized() may still be notifying after the last decrement of m_remaining.
+	m_in_callback.wait_idle();
+}
+
+auto Graph::add(Task& task) -> Graph& {
+	get_or_add(task);
+	return *this;
+}
+
+auto Graph::add_edge(Task& from, Task& to) -> Graph& {
+	assert(!is_busy() && &from != &to);
+	auto& successor = get_or_add(to);
+	get_or_add(from).successors.push_back(&successor);
+	++successor.predecessors;
+	return *this;
+}
+
+void Graph::clear() {
+	assert(!is_busy());
+	m_lookup.clear();
+	m_nodes.clear();
+	m_submitted = false;
+}
+
+auto Graph::get_status() const -> Status {
+	if (!m_submitted) { return Status::None; }
+	if (is_busy()) { return Status::Executing; }
+	return m_dropped ? Status::Dropped : Status::Completed;
+}
+
+auto Graph::submit(Queue& queue) -> bool {
+	if (is_busy() || has_cycle()) { return false; }
+	// an observed Task has been added to a Group and may be enqueued by it at any time.
+	if (std::ranges::any_of(m_nodes, [](Node const& node) { return node.task->is_busy() || node.task->m_observer != nullptr; })) { return false; }
+
+	auto roots = std::vector<Task*>{};
+	for (auto& node : m_nodes) {
+		node.pending = node.predecessors;
+		node.dropped = false;
+		node.task->m_status = Status::None;
+		node.task->m_observer = &node;
+		if (node.predecessors == 0) { roots.push_back(node.task); }
+	}
+	m_queue = &queue;
+	m_dropped = false;
+	m_submitted = true;
+	m_remaining = m_nodes.size();
+	if (!queue.enqueue(roots)) {
+		for (auto& node : m_nodes) { node.task->m_observer = nullptr; }
+		m_remaining = 0;
+		m_submitted = false;
+		return false;
+	}
+	return true;
+}
+
+void Graph::wait() {
+	for (auto remaining = m_remaining.load(); remaining > 0; remaining = m_remaining.load()) { m_remaining.wait(remaining); }
+}
+
+auto Graph::get_or_add(Task& task) -> Node& {
+	assert(!is_busy());
+	auto [it, inserted] = m_lookup.emplace(&task, nullptr);
+	if (inserted) { it->second = &m_nodes.emplace_back(*this, task); }
+	return *it->second;
+}
+
+auto Graph::has_cycle() const -> bool {
+	// Kahn's algorithm: a cycle exists iff some nodes never reach zero in-degree.
+	auto in_degree = std::unordered_map<Node const*, std::size_t>{};
+	auto ready = std::vector<Node const*>{};
+	for (auto const& node : m_nodes) {
+		in_degree[&node] = node.predecessors;
+		if (node.predecessors == 0) { ready.push_back(&node); }
+	}
+	auto visited = std::size_t{};
+	while (!ready.empty()) {
+		auto const* node = ready.back();
+		ready.pop_back();
+		++visited;
+		for (auto const* successor : node->successors) {
+			if (--in_degree[successor] == 0) { ready.push_back(successor); }
+		}
+	}
+	return visited != m_nodes.size();
+}
+
+void Graph::on_finalized(Node& node, Status const status) {
+	m_in_callback.enter();
+	auto unqueued = std::vector<Node*>{};
+	finalize(node, status, unqueued);
+	while (!unqueued.empty()) {
+		// never enqueued: finalize in place instead of recursing through the observer.
+		auto& next = *unqueued.back();
+		unqueued.pop_back();
+		next.task->m_observer = nullptr;
+		if (next.dropped || next.task->is_busy()) {
+			next.task->m_status = Status::Dropped;
+			finalize(next, Status::Dropped, unqueued);
+			continue;
+		}
+		// rejected by a full / draining Queue: run it inline, a drain waits for the whole Graph.
+		next.task->on_enqueued(nullptr);
+		next.task->do_execute();
+		finalize(next, next.task->get_status(), unqueued);
+	}
+	m_in_callback.leave();
+}
+
+// successors that are ready but could not be enqueued (dropped or rejected) are pushed to unqueued.
+void Graph::finalize(Node& node, Status const status, std::vector<Node*>& unqueued) {
+	auto const is_dropped = status == Status::Dropped;
+	if (is_dropped) { m_dropped = true; }
+	for (auto* successor : node.successors) {
+		if (is_dropped) { successor->dropped = true; }
+		if (--successor->pending > 0) { continue; }
+		if (successor->dropped || !m_queue->enqueue(*successor->task)) { unqueued.push_back(successor); }
+	}
+	if (--m_remaining == 0) { m_remaining.notify_all(); }
+}
 } // namespace task
 
-auto task::get_max_threads() -> ThreadCount { return ThreadCount(std::thread::hardware_concurrency()); }
+// hardware_concurrency() may return 0 if unknown.
+auto task::get_max_threads() -> ThreadCount { return ThreadCount(std::max(std::thread::hardware_concurrency(), 1U)); }
 } // namespace klib
 
 // log
@@ -0,0 +1,70 @@
+#include "klib/task/coroutine.hpp"
+#include "klib/unit_test/unit_test.hpp"
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace klib::task;
+
+auto create_queue() -> Queue { return Queue{QueueCreateInfo{.thread_count = ThreadCount{3}}}; }
+
+auto square(Queue& queue, int const value) -> Coroutine<int> {
+	co_await queue.schedule();
+	co_return value * value;
+}
+
+auto get_thread_id(Queue& queue) -> Coroutine<std::thread::id> {
+	co_await queue.schedule();
+	co_return std::this_thread::get_id();
+}
+
+auto sum_of_squares(Queue& queue, int const count) -> Coroutine<int> {
+	auto children = std::vector<Coroutine<int>>{};
+	children.reserve(std::size_t(count));
+	for (auto i = 0; i < count; ++i) { children.push_back(square(queue, i)); }
+	co_await when_all(queue, std::span{children});
+	auto ret = 0;
+	for (auto& child : children) { ret += child.get(); }
+	co_return ret;
+}
+
+auto throws(Queue& queue) -> Coroutine<> {
+	co_await queue.schedule();
+	throw std::runtime_error{"test"};
+}
+
+TEST_CASE(task_coroutine_schedule) {
+	auto queue = create_queue();
+	EXPECT(sync_wait(square(queue, 7)) == 49);
+	EXPECT(sync_wait(get_thread_id(queue)) != std::this_thread::get_id());
+}
+
+TEST_CASE(task_coroutine_when_all) {
+	auto queue = create_queue();
+	static constexpr auto count_v = 1000;
+	auto expected = 0;
+	for (auto i = 0; i < count_v; ++i) { expected += i * i; }
+	EXPECT(sync_wait(sum_of_squares(queue, count_v)) == expected);
+}
+
+TEST_CASE(task_coroutine_nested) {
+	auto queue = create_queue();
+	auto outer = [](Queue& queue) -> Coroutine<int> {
+		auto const a = co_await square(queue, 3);
+		auto const b = co_await sum_of_squares(queue, 4);
+		co_return a + b;
+	};
+	EXPECT(sync_wait(outer(queue)) == 9 + 14);
+}
+
+TEST_CASE(task_coroutine_exception) {
+	auto queue = create_queue();
+	auto caught = false;
+	try {
+		sync_wait(throws(queue));
+	} catch (std::runtime_error const&) { caught = true; }
+	EXPECT(caught);
+}
+} // namespace
@@ -0,0 +1,157 @@
+#include "klib/task/dispatcher.hpp"
+#include "klib/unit_test/unit_test.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace klib::task;
+using namespace std::chrono_literals;
+
+struct AppendTask : Task {
+	std::vector<int>* order{};
+	int value{};
+
+	void execute() final { order->push_back(value); }
+};
+
+TEST_CASE(task_dispatcher_pump) {
+	static constexpr auto producers_v = 4;
+	static constexpr auto per_producer_v = 64;
+	auto dispatcher = Dispatcher{};
+	EXPECT(dispatcher.is_owner_thread());
+	auto order = std::vector<int>{};
+	auto tasks = std::vector<AppendTask>(producers_v * per_producer_v);
+	{
+		auto threads = std::vector<std::jthread>{};
+		for (auto p = 0; p < producers_v; ++p) {
+			threads.emplace_back([&, p] {
+				EXPECT(!dispatcher.is_owner_thread());
+				for (auto i = 0; i < per_producer_v; ++i) {
+					auto& task = tasks.at(std::size_t((p * per_producer_v) + i));
+					task.order = &order;
+					task.value = (p * per_producer_v) + i;
+					dispatcher.enqueue(task);
+				}
+			});
+		}
+	}
+	EXPECT(dispatcher.pending_count() == tasks.size());
+
+	// count budget.
+	EXPECT(dispatcher.pump(PumpBudget{.max_tasks = 10}) == 10);
+	EXPECT(dispatcher.pending_count() == tasks.size() - 10);
+	while (dispatcher.pending_count() > 0) { EXPECT(dispatcher.pump(PumpBudget{.max_tasks = 10}) <= 10); }
+	ASSERT(order.size() == tasks.size());
+
+	// FIFO per producer.
+	auto last = std::array<int, producers_v>{};
+	last.fill(-1);
+	for (auto const value : order) {
+		auto& prev = last.at(std::size_t(value / per_producer_v));
+		EXPECT(value > prev);
+		prev = value;
+	}
+	for (auto const& task : tasks) { EXPECT(task.get_status() == Status::Completed); }
+}
+
+TEST_CASE(task_dispatcher_budget) {
+	struct SleepTask : Task {
+		void execute() final { std::this_thread::sleep_for(2ms); }
+	};
+
+	auto dispatcher = Dispatcher{};
+	auto tasks = std::array<SleepTask, 8>{};
+	for (auto& task : tasks) { dispatcher.enqueue(task); }
+	auto const executed = dispatcher.pump(PumpBudget{.max_duration = 5ms});
+	EXPECT(executed >= 1 && executed <= 3);
+	EXPECT(dispatcher.pending_count() == tasks.size() - executed);
+	EXPECT(dispatcher.pump() == tasks.size() - executed);
+	EXPECT(dispatcher.pump() == 0);
+}
+
+TEST_CASE(task_dispatcher_concurrent) {
+	static constexpr auto producers_v = 4;
+	static constexpr auto per_producer_v = 500;
+	auto dispatcher = Dispatcher{};
+	auto count = std::atomic<int>{};
+	auto shared = AppendTask{};
+	auto order = std::vector<int>{};
+	shared.order = &order;
+	auto claimed = std::atomic<int>{};
+	{
+		auto threads = std::vector<std::jthread>{};
+		for (auto p = 0; p < producers_v; ++p) {
+			threads.emplace_back([&] {
+				// the same Task enqueued by every producer: only one claim succeeds.
+				if (dispatcher.enqueue(shared)) { ++claimed; }
+				// pooled callables grow across several chunks.
+				for (auto i = 0; i < per_producer_v; ++i) { EXPECT(dispatcher.submit([&] { ++count; })); }
+			});
+		}
+	}
+	EXPECT(claimed == 1);
+	EXPECT(dispatcher.pump() == std::size_t((producers_v * per_producer_v) + 1));
+	EXPECT(count == producers_v * per_producer_v);
+	EXPECT(order.size() == 1);
+
+	// recycled slots.
+	for (auto i = 0; i < per_producer_v; ++i) { EXPECT(dispatcher.submit([&] { ++count; })); }
+	EXPECT(dispatcher.pump() == std::size_t(per_producer_v));
+	EXPECT(count == (producers_v + 1) * per_producer_v);
+}
+
+TEST_CASE(task_dispatcher_reentrant) {
+	auto dispatcher = Dispatcher{};
+	auto count = 0;
+	// enqueued while pumping: deferred to the next pump.
+	dispatcher.submit([&] {
+		++count;
+		dispatcher.submit([&] { ++count; });
+	});
+	EXPECT(dispatcher.pump() == 1);
+	EXPECT(count == 1);
+	EXPECT(dispatcher.pending_count() == 1);
+	EXPECT(dispatcher.pump() == 1);
+	EXPECT(count == 2);
+
+	auto order = std::vector<int>{};
+	auto tasks = std::array<AppendTask, 2>{};
+	for (auto& task : tasks) {
+		task.order = &order;
+		dispatcher.enqueue(task);
+	}
+	dispatcher.drop_enqueued();
+	EXPECT(order.empty());
+	for (auto const& task : tasks) { EXPECT(task.get_status() == Status::Dropped); }
+
+	// busy Tasks are rejected: linking them again would corrupt the list.
+	auto busy = AppendTask{};
+	busy.order = &order;
+	EXPECT(dispatcher.enqueue(busy));
+	EXPECT(!dispatcher.enqueue(busy));
+	EXPECT(dispatcher.pending_count() == 1);
+	EXPECT(dispatcher.pump() == 1);
+	EXPECT(order.size() == 1);
+
+	// a moved-from Dispatcher rejects everything.
+	auto moved = std::move(dispatcher);
+	EXPECT(!dispatcher.enqueue(busy));
+	EXPECT(!dispatcher.submit([] {}));
+	EXPECT(busy.get_status() == Status::Completed);
+	EXPECT(moved.submit([] {}));
+	EXPECT(moved.pump() == 1);
+
+	// pending Tasks are dropped on destruction.
+	auto task = AppendTask{};
+	task.order = &order;
+	{
+		auto other = Dispatcher{};
+		other.enqueue(task);
+	}
+	EXPECT(task.get_status() == Status::Dropped);
+	EXPECT(!task.is_busy());
+}
+} // namespace
@@ -0,0 +1,118 @@
+#include "klib/task/graph.hpp"
+#include "klib/task/group.hpp"
+#include "klib/task/queue.hpp"
+#include "klib/unit_test/unit_test.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace klib::task;
+
+struct RecordTask : Task {
+	inline static std::mutex s_mutex{};
+	inline static std::vector<Task const*> s_order{};
+
+	void execute() final {
+		auto lock = std::scoped_lock{s_mutex};
+		s_order.push_back(this);
+	}
+};
+
+[[nodiscard]] auto index_of(Task const& task) -> std::size_t {
+	auto const it = std::ranges::find(RecordTask::s_order, &task);
+	return std::size_t(it - RecordTask::s_order.begin());
+}
+
+TEST_CASE(task_graph_diamond) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{4}}};
+	auto tasks = std::array<RecordTask, 4>{};
+	auto& [a, b, c, d] = tasks;
+	auto graph = Graph{};
+	graph.add_edge(a, b).add_edge(a, c).add_edge(b, d).add_edge(c, d);
+	EXPECT(graph.node_count() == 4);
+
+	for (auto run = 0; run < 2; ++run) {
+		RecordTask::s_order.clear();
+		ASSERT(graph.submit(queue));
+		graph.wait();
+		EXPECT(graph.get_status() == Status::Completed);
+		ASSERT(RecordTask::s_order.size() == 4);
+		EXPECT(index_of(a) == 0);
+		EXPECT(index_of(d) == 3);
+		for (auto const& task : tasks) { EXPECT(task.get_status() == Status::Completed); }
+	}
+}
+
+TEST_CASE(task_graph_cycle) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}}};
+	auto tasks = std::array<RecordTask, 3>{};
+	auto graph = Graph{};
+	graph.add_edge(tasks[0], tasks[1]).add_edge(tasks[1], tasks[2]).add_edge(tasks[2], tasks[0]);
+	EXPECT(!graph.submit(queue));
+	EXPECT(!graph.is_busy());
+}
+
+TEST_CASE(task_graph_drop) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}}};
+	auto tasks = std::array<RecordTask, 4>{};
+	auto& [a, b, c, d] = tasks;
+	auto graph = Graph{};
+	graph.add_edge(a, b).add_edge(b, c).add(d);
+	RecordTask::s_order.clear();
+	queue.pause();
+	ASSERT(graph.submit(queue));
+	EXPECT(graph.is_busy());
+	queue.drop_enqueued();
+	graph.wait();
+	EXPECT(graph.get_status() == Status::Dropped);
+	EXPECT(RecordTask::s_order.empty());
+	for (auto const& task : tasks) { EXPECT(task.get_status() == Status::Dropped); }
+}
+
+TEST_CASE(task_graph_drained) {
+	struct SlowTask : Task {
+		void execute() final {
+			std::this_thread::sleep_for(std::chrono::milliseconds{20});
+			auto lock = std::scoped_lock{RecordTask::s_mutex};
+			RecordTask::s_order.push_back(this);
+		}
+	};
+
+	// later stages are rejected while the Queue drains: they run inline instead of being dropped.
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}}};
+	auto root = SlowTask{};
+	auto tasks = std::array<RecordTask, 3>{};
+	auto graph = Graph{};
+	graph.add_edge(root, tasks[0]).add_edge(tasks[0], tasks[1]).add_edge(tasks[1], tasks[2]);
+	RecordTask::s_order.clear();
+	ASSERT(graph.submit(queue));
+	queue.drain_and_wait();
+	graph.wait();
+	EXPECT(graph.get_status() == Status::Completed);
+	ASSERT(RecordTask::s_order.size() == 4);
+	EXPECT(index_of(root) == 0);
+	for (std::size_t i = 0; i < tasks.size(); ++i) {
+		EXPECT(index_of(tasks.at(i)) == i + 1);
+		EXPECT(tasks.at(i).get_status() == Status::Completed);
+	}
+}
+
+TEST_CASE(task_graph_observed) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}}};
+	auto tasks = std::array<RecordTask, 2>{};
+	auto group = Group{};
+	ASSERT(group.add(tasks[1]));
+	// tasks[1] belongs to the Group: the Graph must not take over its observer.
+	auto graph = Graph{};
+	graph.add_edge(tasks[0], tasks[1]);
+	EXPECT(!graph.submit(queue));
+	EXPECT(!graph.is_busy());
+	EXPECT(!tasks[0].is_busy());
+	EXPECT(queue.enqueue(tasks[1]));
+	group.wait();
+}
+} // namespace
@@ -0,0 +1,121 @@
+#include "klib/task/group.hpp"
+#include "klib/task/queue.hpp"
+#include "klib/unit_test/unit_test.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+using namespace klib::task;
+using namespace std::chrono_literals;
+
+struct SleepTask : Task {
+	inline static std::atomic<int> s_executed{};
+	std::chrono::milliseconds duration{};
+
+	void execute() final {
+		std::this_thread::sleep_for(duration);
+		++s_executed;
+	}
+};
+
+struct AddTask : Task {
+	Queue* queue{};
+	Group* group{};
+	SleepTask* child{};
+
+	void execute() final { group->enqueue(*queue, *child); }
+};
+
+TEST_CASE(task_group_wait) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}}};
+	SleepTask::s_executed = 0;
+	auto tasks = std::array<SleepTask, 8>{};
+	auto group = Group{};
+	for (auto& task : tasks) {
+		task.duration = 1ms;
+		EXPECT(group.enqueue(queue, task));
+	}
+	group.wait();
+	EXPECT(group.is_done());
+	EXPECT(SleepTask::s_executed == int(tasks.size()));
+	for (auto const& task : tasks) { EXPECT(!task.is_busy()); }
+}
+
+TEST_CASE(task_group_add_while_running) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}}};
+	SleepTask::s_executed = 0;
+	auto children = std::array<SleepTask, 4>{};
+	auto parents = std::array<AddTask, 4>{};
+	auto group = Group{};
+	for (std::size_t i = 0; i < parents.size(); ++i) {
+		parents.at(i).queue = &queue;
+		parents.at(i).group = &group;
+		parents.at(i).child = &children.at(i);
+		group.enqueue(queue, parents.at(i));
+	}
+	// each parent adds its child before it finishes: pending never reaches zero in between.
+	group.wait();
+	EXPECT(SleepTask::s_executed == int(children.size()));
+}
+
+TEST_CASE(task_group_wait_for) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}}};
+	auto task = SleepTask{};
+	task.duration = 100ms;
+	auto group = Group{};
+	group.enqueue(queue, task);
+	EXPECT(!group.wait_for(1ms));
+	EXPECT(group.wait_for(5s));
+}
+
+TEST_CASE(task_group_wait_any) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}}};
+	auto tasks = std::array<SleepTask, 3>{};
+	auto group = Group{};
+	EXPECT(!group.wait_any());
+	for (auto& task : tasks) {
+		task.duration = 2ms;
+		group.enqueue(queue, task);
+	}
+	for (std::size_t i = 0; i < tasks.size(); ++i) { EXPECT(group.wait_any()); }
+	EXPECT(!group.wait_any());
+	EXPECT(group.is_done());
+}
+
+TEST_CASE(task_group_dropped) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}}};
+	queue.pause();
+	auto tasks = std::array<SleepTask, 2>{};
+	auto group = Group{};
+	for (auto& task : tasks) { group.enqueue(queue, task); }
+	queue.drop_enqueued();
+	group.wait();
+	EXPECT(group.dropped_count() == tasks.size());
+}
+
+TEST_CASE(task_group_observed) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}}};
+	auto task = SleepTask{};
+	auto other = SleepTask{};
+	auto first = Group{};
+	auto second = Group{};
+	// a Task has a single observer: it cannot be tracked by two Groups at once.
+	EXPECT(first.add(task));
+	EXPECT(!second.add(task));
+	auto const both = std::array<Task*, 2>{&other, &task};
+	EXPECT(!second.enqueue(queue, both));
+	EXPECT(second.is_done());
+	EXPECT(!other.is_busy());
+	EXPECT(queue.fork_join(both) == Status::Dropped);
+	EXPECT(!other.is_busy());
+
+	EXPECT(queue.enqueue(task));
+	first.wait();
+	// observers are one-shot: a finished Task can be tracked again.
+	EXPECT(second.enqueue(queue, both));
+	second.wait();
+	EXPECT(other.get_status() == Status::Completed && task.get_status() == Status::Completed);
+}
+} // namespace
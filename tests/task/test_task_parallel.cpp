@@ -0,0 +1,80 @@
+#include "klib/task/parallel.hpp"
+#include "klib/unit_test/unit_test.hpp"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace klib::task;
+
+auto create_queue() -> Queue { return Queue{QueueCreateInfo{.thread_count = ThreadCount{3}}}; }
+
+TEST_CASE(task_parallel_for) {
+	auto queue = create_queue();
+	for (auto const split : {Split::Static, Split::Adaptive}) {
+		auto visits = std::vector<std::atomic<int>>(1000);
+		parallel_for(queue, 0, visits.size(), [&](std::size_t const i) { ++visits.at(i); }, Partition{.grain_size = 7, .split = split});
+		EXPECT(std::ranges::all_of(visits, [](std::atomic<int> const& v) { return v == 1; }));
+	}
+
+	auto values = std::vector<int>(100, 1);
+	parallel_for(queue, std::span{values}, [](int& value) { value *= 2; });
+	EXPECT(std::ranges::all_of(values, [](int const v) { return v == 2; }));
+
+	auto called = false;
+	parallel_for(queue, 5, 5, [&](std::size_t) { called = true; });
+	EXPECT(!called);
+}
+
+TEST_CASE(task_parallel_reduce) {
+	auto queue = create_queue();
+	auto values = std::vector<std::uint64_t>(10'000);
+	std::iota(values.begin(), values.end(), 1);
+	auto const expected = std::accumulate(values.begin(), values.end(), std::uint64_t{10});
+	auto const plus = [](std::uint64_t const a, std::uint64_t const b) { return a + b; };
+	for (auto const split : {Split::Static, Split::Adaptive}) {
+		auto const partition = Partition{.grain_size = 13, .split = split};
+		EXPECT(parallel_reduce(queue, std::span<std::uint64_t const>{values}, std::uint64_t{10}, plus, partition) == expected);
+	}
+	auto const sum = parallel_reduce(queue, 0, 100, 0uz, [](std::size_t const i) { return i; }, plus);
+	EXPECT(sum == 4950);
+	EXPECT(parallel_reduce(queue, 3, 3, 42, [](std::size_t) { return 0; }, plus) == 42);
+}
+
+TEST_CASE(task_parallel_transform) {
+	auto queue = create_queue();
+	auto input = std::vector<int>(500);
+	std::iota(input.begin(), input.end(), 0);
+	auto output = std::vector<long>(input.size());
+	parallel_transform(queue, std::span<int const>{input}, std::span{output}, [](int const v) { return long(v) * v; }, Partition{.split = Split::Adaptive});
+	auto ok = true;
+	for (std::size_t i = 0; i < input.size(); ++i) { ok = ok && output.at(i) == long(input.at(i)) * input.at(i); }
+	EXPECT(ok);
+}
+
+TEST_CASE(task_parallel_draining) {
+	struct GateTask : Task {
+		std::atomic_bool open{};
+
+		void execute() final { open.wait(false); }
+	};
+
+	auto queue = create_queue();
+	auto gate = GateTask{};
+	EXPECT(queue.enqueue(gate));
+	auto drainer = std::jthread{[&] { queue.drain_and_wait(); }};
+	while (queue.can_enqueue(1)) { std::this_thread::yield(); }
+
+	// rejected by the draining Queue: runs inline instead.
+	auto visits = std::vector<int>(200);
+	parallel_for(queue, 0, visits.size(), [&](std::size_t const i) { ++visits.at(i); }, Partition{.grain_size = 8});
+	EXPECT(std::ranges::all_of(visits, [](int const v) { return v == 1; }));
+	auto const plus = [](std::size_t const a, std::size_t const b) { return a + b; };
+	EXPECT(parallel_reduce(queue, 0, 100, 0uz, [](std::size_t const i) { return i; }, plus, Partition{.grain_size = 4}) == 4950);
+
+	gate.open = true;
+	gate.open.notify_all();
+}
+} // namespace
@@ -1,9 +1,13 @@
 #include "klib/task/queue.hpp"
 #include "klib/unit_test/unit_test.hpp"
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include <random>
 #include <thread>
+#include <vector>
 
 namespace {
 using namespace klib::task;
@@ -70,6 +74,33 @@ TEST_CASE(task_queue_drain_restart) {
 	EXPECT(WaitTask::s_executed == 3);
 }
 
+TEST_CASE(task_queue_drain_keeps_workers) {
+	struct IdTask : Task {
+		std::thread::id thread_id{};
+
+		void execute() final { thread_id = std::this_thread::get_id(); }
+	};
+
+	auto create_info = create_info_v;
+	create_info.collect_stats = true;
+	auto queue = Queue{create_info};
+	// thread ids may be reused by respawned threads: count starts instead.
+	auto const worker_starts = queue.snapshot().worker_starts;
+	EXPECT(worker_starts == std::uint64_t(queue.thread_count()));
+	auto thread_ids = std::vector<std::thread::id>{};
+	auto tasks = std::array<IdTask, 4>{};
+	for (auto run = 0; run < 100; ++run) {
+		for (auto& task : tasks) { queue.enqueue(task); }
+		queue.drain_and_wait();
+		for (auto const& task : tasks) {
+			EXPECT(!task.is_busy());
+			if (std::ranges::find(thread_ids, task.thread_id) == thread_ids.end()) { thread_ids.push_back(task.thread_id); }
+		}
+	}
+	EXPECT(thread_ids.size() <= std::size_t(queue.thread_count()));
+	EXPECT(queue.snapshot().worker_starts == worker_starts);
+}
+
 TEST_CASE(task_queue_task_wait) {
 	auto queue = create_queue();
 	queue.pause();
@@ -87,6 +118,46 @@ TEST_CASE(task_queue_task_wait) {
 	EXPECT(queue.is_empty());
 }
 
+TEST_CASE(task_queue_task_wait_for) {
+	auto queue = create_queue();
+	queue.pause();
+	auto task = WaitTask{20ms};
+	EXPECT(task.wait_for(0ms));
+	queue.enqueue(task);
+	EXPECT(!task.wait_for(10ms));
+	EXPECT(!task.wait_until(std::chrono::steady_clock::now() + 1ms));
+	queue.resume();
+	EXPECT(task.wait_for(10s));
+	EXPECT(task.get_status() == Task::Status::Completed);
+}
+
+TEST_CASE(task_queue_wait_any) {
+	struct BlockTask : Task {
+		void execute() final {
+			while (!stop_requested()) { std::this_thread::sleep_for(1ms); }
+		}
+	};
+
+	EXPECT(wait_any({}) == nullptr);
+	auto queue = create_queue();
+	auto fast = WaitTask{10ms};
+	auto slow = BlockTask{};
+	auto idle = WaitTask{};
+	queue.pause();
+	queue.enqueue(fast);
+	queue.enqueue(slow);
+	auto const tasks = std::array<Task*, 2>{&slow, &fast};
+	EXPECT(wait_any_for(tasks, 5ms) == nullptr);
+	auto const with_idle = std::array<Task*, 3>{&slow, &fast, &idle};
+	EXPECT(wait_any(with_idle) == &idle);
+
+	queue.resume();
+	EXPECT(wait_any(tasks) == &fast);
+	EXPECT(slow.is_busy());
+	queue.cancel(slow);
+	EXPECT(slow.wait_for(10s));
+}
+
 TEST_CASE(task_queue_task_drop) {
 	auto queue = create_queue();
 	queue.pause();
@@ -126,4 +197,505 @@ TEST_CASE(task_queue_task_rerun) {
 	EXPECT(!task.is_busy());
 	EXPECT(queue.is_empty());
 }
+
+struct SpawnTask : Task {
+	inline static std::atomic<int> s_executed{};
+	Queue* queue{};
+	std::array<WaitTask, 4> children{WaitTask{1ms}, WaitTask{1ms}, WaitTask{1ms}, WaitTask{1ms}};
+
+	void execute() final {
+		for (auto& child : children) { queue->enqueue(child); }
+		++s_executed;
+	}
+};
+
+TEST_CASE(task_queue_work_stealing) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{4}, .scheduler = Scheduler::WorkStealing}};
+	queue.pause();
+	WaitTask::s_executed = 0;
+	SpawnTask::s_executed = 0;
+	auto tasks = std::array<SpawnTask, 8>{};
+	for (auto& task : tasks) {
+		task.queue = &queue;
+		queue.enqueue(task);
+	}
+	EXPECT(queue.enqueued_count() == tasks.size());
+	queue.resume();
+	for (auto& task : tasks) { task.wait(); }
+	for (auto& task : tasks) {
+		for (auto& child : task.children) { child.wait(); }
+	}
+	EXPECT(SpawnTask::s_executed == int(tasks.size()));
+	EXPECT(WaitTask::s_executed == int(tasks.size() * 4));
+	EXPECT(queue.is_empty());
+
+	auto wait_tasks = std::array<WaitTask, 8>{};
+	auto to_join = std::array<Task*, 8>{};
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+	for (std::size_t i = 0; i < wait_tasks.size(); ++i) { to_join[i] = &wait_tasks[i]; }
+	WaitTask::s_executed = 0;
+	EXPECT(queue.fork_join(to_join) == Task::Status::Completed);
+	EXPECT(WaitTask::s_executed == int(wait_tasks.size()));
+
+	queue.pause();
+	WaitTask::s_executed = 0;
+	queue.enqueue(to_join);
+	queue.drain_and_wait();
+	EXPECT(WaitTask::s_executed == int(wait_tasks.size()));
+	EXPECT(queue.is_empty());
+}
+
+struct CountTask : Task {
+	inline static std::atomic<int> s_executed{};
+
+	void execute() final { ++s_executed; }
+};
+
+TEST_CASE(task_queue_idle_policy) {
+	for (auto const mode : {IdleMode::Adaptive, IdleMode::Park}) {
+		auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}, .idle_policy = IdlePolicy{.mode = mode}}};
+		WaitTask::s_executed = 0;
+		auto tasks = std::array<WaitTask, 4>{};
+		for (auto round = 0; round < 3; ++round) {
+			for (auto& task : tasks) {
+				task.duration = {};
+				queue.enqueue(task);
+			}
+			for (auto& task : tasks) { task.wait(); }
+			std::this_thread::sleep_for(1ms);
+		}
+		EXPECT(WaitTask::s_executed == int(tasks.size() * 3));
+	}
+}
+
+TEST_CASE(task_queue_affinity) {
+	static constexpr auto cpus_v = std::array{0u};
+	for (auto const mode : {Affinity::Compact, Affinity::Scatter, Affinity::Explicit, Affinity::PerNumaNode}) {
+		auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{4}, .affinity = AffinityPolicy{.mode = mode, .cpus = cpus_v}}};
+		queue.pause();
+		WaitTask::s_executed = 0;
+		SpawnTask::s_executed = 0;
+		auto tasks = std::array<SpawnTask, 4>{};
+		for (auto& task : tasks) {
+			task.queue = &queue;
+			queue.enqueue(task);
+		}
+		queue.resume();
+		for (auto& task : tasks) { task.wait(); }
+		for (auto& task : tasks) {
+			for (auto& child : task.children) { child.wait(); }
+		}
+		EXPECT(SpawnTask::s_executed == int(tasks.size()));
+		EXPECT(WaitTask::s_executed == int(tasks.size() * 4));
+	}
+}
+
+TEST_CASE(task_queue_worker_groups) {
+	for (auto const scheduler : {Scheduler::Shared, Scheduler::WorkStealing}) {
+		// one group per worker (thread_count is clamped to the hardware concurrency).
+		auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{4}, .scheduler = scheduler, .worker_group_size = 1}};
+		EXPECT(queue.worker_group_count() == std::size_t(queue.thread_count()));
+		queue.pause();
+		WaitTask::s_executed = 0;
+		SpawnTask::s_executed = 0;
+		auto tasks = std::array<SpawnTask, 8>{};
+		for (auto& task : tasks) {
+			task.queue = &queue;
+			queue.enqueue(task);
+		}
+		queue.resume();
+		for (auto& task : tasks) { task.wait(); }
+		for (auto& task : tasks) {
+			for (auto& child : task.children) { child.wait(); }
+		}
+		EXPECT(SpawnTask::s_executed == int(tasks.size()));
+		EXPECT(WaitTask::s_executed == int(tasks.size() * 4));
+
+		queue.pause();
+		for (auto& task : tasks) { queue.enqueue(task); }
+		queue.drop_enqueued();
+		EXPECT(queue.is_empty());
+		for (auto const& task : tasks) { EXPECT(task.get_status() == Status::Dropped); }
+	}
+}
+
+TEST_CASE(task_queue_worker_groups_steal) {
+	// the spawning worker waits for its children: they can only run on workers of other groups.
+	struct HoldingSpawnTask : Task {
+		Queue* queue{};
+		std::array<WaitTask, 4> children{WaitTask{1ms}, WaitTask{1ms}, WaitTask{1ms}, WaitTask{1ms}};
+
+		void execute() final {
+			for (auto& child : children) { queue->enqueue(child); }
+			for (auto& child : children) { child.wait(); }
+		}
+	};
+
+	for (auto const scheduler : {Scheduler::Shared, Scheduler::WorkStealing}) {
+		auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{4}, .scheduler = scheduler, .worker_group_size = 1}};
+		// a single worker would wait on itself.
+		if (std::size_t(queue.thread_count()) < 2) { return; }
+		EXPECT(queue.worker_group_count() == std::size_t(queue.thread_count()));
+		auto task = HoldingSpawnTask{};
+		task.queue = &queue;
+		WaitTask::s_executed = 0;
+		EXPECT(queue.enqueue(task));
+		EXPECT(task.wait_for(5s));
+		EXPECT(WaitTask::s_executed == int(task.children.size()));
+	}
+}
+
+TEST_CASE(task_queue_stats) {
+	EXPECT(create_queue().snapshot().workers.empty());
+
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}, .collect_stats = true}};
+	queue.pause();
+	auto tasks = std::array<WaitTask, 6>{};
+	for (auto& task : tasks) {
+		task.duration = 1ms;
+		queue.enqueue(task);
+	}
+	queue.drain_and_wait();
+	auto const stats = queue.snapshot();
+	EXPECT(stats.workers.size() == std::size_t(queue.thread_count()) + 1);
+	auto executed = std::uint64_t{};
+	auto busy_time = std::chrono::nanoseconds{};
+	for (auto const& worker : stats.workers) {
+		executed += worker.executed;
+		busy_time += worker.busy_time;
+	}
+	EXPECT(executed == tasks.size());
+	EXPECT(busy_time >= 6ms);
+	EXPECT(stats.depth_high_water == tasks.size());
+	EXPECT(stats.start_latency.count == tasks.size());
+	EXPECT(stats.execute_duration.count == tasks.size());
+	EXPECT(stats.execute_duration.percentile(50.0) >= 1ms);
+}
+
+TEST_CASE(task_queue_elastic) {
+	auto const elastic = ElasticPolicy{.max_threads = ThreadCount{4}, .depth_per_thread = 1, .idle_timeout = 20ms};
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}, .elastic = elastic}};
+	EXPECT(queue.active_thread_count() == ThreadCount{1});
+	WaitTask::s_executed = 0;
+	auto tasks = std::array<WaitTask, 16>{};
+	for (auto& task : tasks) {
+		task.duration = 5ms;
+		queue.enqueue(task);
+	}
+	EXPECT(queue.active_thread_count() > ThreadCount{1});
+	queue.drain_and_wait();
+	EXPECT(WaitTask::s_executed == int(tasks.size()));
+
+	auto const deadline = std::chrono::steady_clock::now() + 5s;
+	while (queue.active_thread_count() > ThreadCount{1} && std::chrono::steady_clock::now() < deadline) { std::this_thread::sleep_for(5ms); }
+	EXPECT(queue.active_thread_count() == ThreadCount{1});
+	auto const history = queue.resize_history();
+	ASSERT(!history.empty());
+	EXPECT(history.front().reason != ResizeReason::Idle);
+	EXPECT(history.back().reason == ResizeReason::Idle);
+	EXPECT(history.back().thread_count == ThreadCount{1});
+}
+
+TEST_CASE(task_queue_elastic_spinning) {
+	// a worker waiting under the idle policy picks up the backlog: no thread is spawned for it.
+	auto const elastic = ElasticPolicy{.max_threads = ThreadCount{4}, .depth_per_thread = 1, .wait_threshold = 1h};
+	auto const idle_policy = IdlePolicy{.mode = IdleMode::Adaptive, .spin_duration = {}, .yield_duration = 2s};
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}, .idle_policy = idle_policy, .elastic = elastic}};
+	queue.pause();
+	std::this_thread::sleep_for(5ms);
+	auto tasks = std::array<WaitTask, 4>{};
+	for (auto& task : tasks) {
+		task.duration = {};
+		queue.enqueue(task);
+	}
+	EXPECT(queue.active_thread_count() == ThreadCount{1});
+	queue.drain_and_wait();
+	EXPECT(queue.resize_history().empty());
+}
+
+TEST_CASE(task_queue_cancel) {
+	auto queue = create_queue();
+	queue.pause();
+	WaitTask::s_executed = 0;
+	auto tasks = std::array<WaitTask, 3>{};
+	for (auto& task : tasks) {
+		task.duration = {};
+		queue.enqueue(task);
+	}
+	EXPECT(queue.cancel(tasks[1]));
+	EXPECT(!queue.cancel(tasks[1]));
+	queue.drain_and_wait();
+	EXPECT(WaitTask::s_executed == 2);
+	EXPECT(tasks[0].get_status() == Status::Completed);
+	EXPECT(tasks[1].get_status() == Status::Dropped);
+	EXPECT(!queue.cancel(tasks[0]));
+
+	struct PollTask : Task {
+		std::atomic_bool started{};
+
+		void execute() final {
+			started = true;
+			started.notify_all();
+			while (!stop_requested()) { std::this_thread::yield(); }
+		}
+	};
+	auto poll = PollTask{};
+	queue.enqueue(poll);
+	poll.started.wait(false);
+	EXPECT(!queue.cancel(poll));
+	poll.wait();
+	EXPECT(poll.get_status() == Status::Completed);
+}
+
+TEST_CASE(task_queue_cancel_foreign) {
+	auto queue = create_queue();
+	auto other = create_queue();
+	other.pause();
+	auto task = WaitTask{0ms};
+	EXPECT(other.enqueue(task));
+	// owned by other: neither dropped nor asked to stop.
+	EXPECT(!queue.cancel(task));
+	EXPECT(task.get_status() == Status::Queued && !task.stop_requested());
+	EXPECT(other.cancel(task));
+	other.drain_and_wait();
+	EXPECT(task.get_status() == Status::Dropped);
+}
+
+TEST_CASE(task_queue_submit) {
+	auto queue = create_queue();
+	auto counter = std::atomic<int>{};
+	for (auto i = 0; i < 100; ++i) {
+		while (!queue.submit([&counter] { ++counter; })) { std::this_thread::yield(); }
+	}
+	// larger than the inline buffer: stored on the heap.
+	auto large = std::array<int, 64>{};
+	large.back() = 42;
+	while (!queue.submit([&counter, large] { counter += large.back(); })) { std::this_thread::yield(); }
+	queue.drain_and_wait();
+	EXPECT(counter == 100 + 42);
+
+	// destruction of the callable when dropped.
+	auto token = std::make_shared<int>();
+	queue.pause();
+	EXPECT(queue.submit([token] {}));
+	EXPECT(token.use_count() == 2);
+	queue.drop_enqueued();
+	EXPECT(token.use_count() == 1);
+	queue.resume();
+}
+
+TEST_CASE(task_queue_bounded) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}, .max_elements = ElementCount{4}}};
+	EXPECT(queue.max_elements() == ElementCount{4});
+	queue.pause();
+	auto tasks = std::array<CountTask, 5>{};
+	for (std::size_t i = 0; i < 4; ++i) { EXPECT(queue.enqueue(tasks.at(i))); }
+	EXPECT(!queue.can_enqueue());
+	EXPECT(!queue.enqueue(tasks.back()));
+	EXPECT(!tasks.back().is_busy());
+	EXPECT(queue.enqueued_count() == 4);
+	queue.drain_and_wait();
+	EXPECT(queue.is_empty());
+	EXPECT(queue.can_enqueue(4));
+	EXPECT(!queue.can_enqueue(5));
+}
+
+TEST_CASE(task_queue_bounded_contended) {
+	static constexpr auto producers_v = 4;
+	static constexpr auto per_producer_v = 256;
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{3}, .max_elements = ElementCount{8}}};
+	CountTask::s_executed = 0;
+	auto tasks = std::vector<CountTask>(producers_v * per_producer_v);
+	{
+		auto threads = std::vector<std::jthread>{};
+		for (auto p = 0; p < producers_v; ++p) {
+			threads.emplace_back([&, p] {
+				for (auto i = 0; i < per_producer_v; ++i) {
+					auto& task = tasks.at(std::size_t((p * per_producer_v) + i));
+					while (!queue.enqueue(task)) { std::this_thread::yield(); }
+				}
+			});
+		}
+	}
+	for (auto& task : tasks) { task.wait(); }
+	EXPECT(CountTask::s_executed == producers_v * per_producer_v);
+	EXPECT(queue.is_empty());
+}
+
+TEST_CASE(task_queue_backpressure) {
+	struct IndexTask : Task {
+		std::size_t index{};
+		std::vector<std::size_t>* order{};
+
+		void execute() final { order->push_back(index); }
+	};
+
+	// a single worker: execution order is admission order.
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}, .max_elements = ElementCount{1}}};
+	queue.pause();
+	auto order = std::vector<std::size_t>{};
+	auto tasks = std::array<IndexTask, 4>{};
+	for (std::size_t i = 0; i < tasks.size(); ++i) {
+		tasks.at(i).index = i;
+		tasks.at(i).order = &order;
+	}
+	// idle: only rejected because of backpressure.
+	auto extra = IndexTask{};
+	extra.order = &order;
+	EXPECT(queue.try_enqueue(tasks[0]));
+	EXPECT(!queue.try_enqueue(tasks[1]));
+	EXPECT(!queue.enqueue_for(tasks[1], 5ms));
+	EXPECT(!tasks[1].is_busy());
+	auto const too_many = std::array<Task*, 2>{&tasks[1], &tasks[2]};
+	EXPECT(!queue.enqueue_wait(too_many));
+
+	// producers are admitted in arrival order, each time the worker frees a slot.
+	{
+		auto producers = std::vector<std::jthread>{};
+		for (std::size_t i = 1; i < tasks.size(); ++i) {
+			producers.emplace_back([&queue, &task = tasks.at(i)] { EXPECT(queue.enqueue_wait(task)); });
+			std::this_thread::sleep_for(20ms);
+		}
+		EXPECT(!queue.try_enqueue(extra));
+		EXPECT(!extra.is_busy());
+		queue.resume();
+	}
+	queue.drain_and_wait();
+	EXPECT((order == std::vector<std::size_t>{0, 1, 2, 3}));
+}
+
+struct OrderTask : Task {
+	inline static std::mutex s_mutex{};
+	inline static std::vector<Priority> s_order{};
+
+	void execute() final {
+		auto lock = std::scoped_lock{s_mutex};
+		s_order.push_back(get_priority());
+	}
+};
+
+TEST_CASE(task_queue_priority) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}}};
+	queue.pause();
+	OrderTask::s_order.clear();
+	auto low = std::array<OrderTask, 2>{};
+	auto normal = std::array<OrderTask, 2>{};
+	auto high = OrderTask{};
+	high.set_priority(Priority::High);
+	for (auto& task : low) { queue.enqueue(task, Priority::Low); }
+	for (auto& task : normal) { queue.enqueue(task); }
+	queue.enqueue(high);
+	queue.drain_and_wait();
+	auto const expected = std::array{Priority::High, Priority::Normal, Priority::Normal, Priority::Low, Priority::Low};
+	EXPECT(std::ranges::equal(OrderTask::s_order, expected));
+}
+
+TEST_CASE(task_queue_priority_aging) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}, .lane_aging = 1ns}};
+	queue.pause();
+	OrderTask::s_order.clear();
+	auto low = OrderTask{};
+	auto high = std::array<OrderTask, 4>{};
+	queue.enqueue(low, Priority::Low);
+	for (auto& task : high) { queue.enqueue(task, Priority::High); }
+	std::this_thread::sleep_for(1ms);
+	queue.drain_and_wait();
+	ASSERT(OrderTask::s_order.size() == 5);
+	EXPECT(OrderTask::s_order.back() != Priority::Low);
+}
+
+TEST_CASE(task_queue_bounded_priorities) {
+	struct IndexTask : Task {
+		std::size_t index{};
+		std::vector<std::size_t>* order{};
+
+		void execute() final { order->push_back(index); }
+	};
+
+	// max_elements bounds the whole Queue, not each priority lane.
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}, .max_elements = ElementCount{9}}};
+	queue.pause();
+	auto order = std::vector<std::size_t>{};
+	auto tasks = std::array<IndexTask, 10>{};
+	for (std::size_t i = 0; i < tasks.size(); ++i) {
+		tasks.at(i).index = i;
+		tasks.at(i).order = &order;
+	}
+	auto const priorities = std::array{Priority::Low, Priority::Normal, Priority::High};
+	for (std::size_t i = 0; i < 9; ++i) { EXPECT(queue.enqueue(tasks.at(i), priorities.at(i % 3))); }
+	for (auto const priority : priorities) { EXPECT(!queue.enqueue(tasks.back(), priority)); }
+	EXPECT(queue.enqueued_count() == 9);
+	queue.drain_and_wait();
+	EXPECT(order.size() == 9);
+
+	// a single lane can still take all of them, past its share of preallocated slots, in FIFO order.
+	order.clear();
+	queue.pause();
+	for (std::size_t i = 0; i < 9; ++i) { EXPECT(queue.enqueue(tasks.at(i), Priority::Normal)); }
+	EXPECT(!queue.enqueue(tasks.back(), Priority::High));
+	queue.drain_and_wait();
+	EXPECT((order == std::vector<std::size_t>{0, 1, 2, 3, 4, 5, 6, 7, 8}));
+}
+
+TEST_CASE(task_queue_priority_rejected) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}, .max_elements = ElementCount{2}}};
+	queue.pause();
+	auto tasks = std::array<OrderTask, 3>{};
+	EXPECT(queue.enqueue(tasks[0], Priority::Low));
+	// busy: neither re-enqueued nor re-prioritized.
+	EXPECT(!queue.enqueue(tasks[0], Priority::High));
+	EXPECT(tasks[0].get_priority() == Priority::Low);
+	// a rejected batch is left untouched.
+	auto const batch = std::array<Task*, 2>{&tasks[1], &tasks[2]};
+	EXPECT(!queue.enqueue(batch, Priority::High));
+	EXPECT(tasks[1].get_priority() == Priority::Normal && tasks[2].get_priority() == Priority::Normal);
+	EXPECT(!tasks[1].is_busy() && !tasks[2].is_busy());
+	queue.drain_and_wait();
+	EXPECT(queue.enqueue(batch, Priority::High));
+	EXPECT(tasks[1].get_priority() == Priority::High);
+	queue.drain_and_wait();
+}
+
+struct NestedJoinTask : Task {
+	inline static std::atomic<int> s_executed{};
+	Queue* queue{};
+	Task::Status result{};
+
+	void execute() final {
+		auto children = std::array<CountTask, 4>{};
+		auto to_join = std::array<Task*, 4>{};
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+		for (std::size_t i = 0; i < children.size(); ++i) { to_join[i] = &children[i]; }
+		result = queue->fork_join(to_join);
+		++s_executed;
+	}
+};
+
+TEST_CASE(task_queue_fork_join_nested) {
+	// every worker blocks in a nested fork_join: callers must run their own batch.
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}}};
+	NestedJoinTask::s_executed = 0;
+	CountTask::s_executed = 0;
+	auto tasks = std::array<NestedJoinTask, 8>{};
+	auto to_join = std::array<Task*, 8>{};
+	for (std::size_t i = 0; i < tasks.size(); ++i) {
+		tasks.at(i).queue = &queue;
+		to_join.at(i) = &tasks.at(i);
+	}
+	EXPECT(queue.fork_join(to_join) == Task::Status::Completed);
+	EXPECT(NestedJoinTask::s_executed == int(tasks.size()));
+	EXPECT(CountTask::s_executed == int(tasks.size() * 4));
+	for (auto const& task : tasks) { EXPECT(task.result == Task::Status::Completed); }
+}
+
+TEST_CASE(task_queue_fork_join_paused) {
+	// the caller participates, so a paused queue still completes the batch.
+	auto queue = create_queue();
+	queue.pause();
+	CountTask::s_executed = 0;
+	auto tasks = std::array<CountTask, 3>{};
+	auto to_join = std::array<Task*, 3>{&tasks[0], &tasks[1], &tasks[2]};
+	EXPECT(queue.fork_join(to_join) == Task::Status::Completed);
+	EXPECT(CountTask::s_executed == 3);
+}
 } // namespace
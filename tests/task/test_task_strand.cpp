@@ -0,0 +1,173 @@
+#include "klib/task/queue.hpp"
+#include "klib/task/strand.hpp"
+#include "klib/unit_test/unit_test.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace {
+using namespace klib::task;
+
+struct Sequence {
+	std::vector<int> order{};
+	std::atomic<int> running{};
+	std::atomic<bool> overlapped{};
+};
+
+struct AppendTask : Task {
+	Sequence* sequence{};
+	int value{};
+
+	void execute() final {
+		if (sequence->running.fetch_add(1) > 0) { sequence->overlapped = true; }
+		sequence->order.push_back(value);
+		--sequence->running;
+	}
+};
+
+auto is_ordered(std::vector<int> const& order, std::size_t const expected) -> bool {
+	if (order.size() != expected) { return false; }
+	for (std::size_t i = 0; i < order.size(); ++i) {
+		if (order[i] != int(i)) { return false; }
+	}
+	return true;
+}
+
+TEST_CASE(task_strand_order) {
+	static constexpr auto strand_count_v = std::size_t{4};
+	static constexpr auto task_count_v = std::size_t{500};
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{4}}};
+	auto sequences = std::array<Sequence, strand_count_v>{};
+	auto tasks = std::vector<AppendTask>(strand_count_v * task_count_v);
+	{
+		auto strands = std::vector<std::unique_ptr<Strand>>{};
+		for (std::size_t i = 0; i < strand_count_v; ++i) { strands.push_back(std::make_unique<Strand>(queue)); }
+		for (std::size_t i = 0; i < task_count_v; ++i) {
+			for (std::size_t s = 0; s < strand_count_v; ++s) {
+				auto& task = tasks[(s * task_count_v) + i];
+				task.sequence = &sequences.at(s);
+				task.value = int(i);
+				strands[s]->enqueue(task);
+			}
+		}
+		for (auto& strand : strands) { strand->wait(); }
+	}
+	for (auto const& sequence : sequences) {
+		EXPECT(!sequence.overlapped);
+		EXPECT(is_ordered(sequence.order, task_count_v));
+	}
+}
+
+TEST_CASE(task_strand_rejected) {
+	// a bounded queue that is full: the Strand runs its Tasks inline.
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}, .max_elements = ElementCount{1}}};
+	queue.pause();
+	auto blocker = AppendTask{};
+	auto blocker_sequence = Sequence{};
+	blocker.sequence = &blocker_sequence;
+	queue.enqueue(blocker);
+
+	auto sequence = Sequence{};
+	auto tasks = std::array<AppendTask, 3>{};
+	auto strand = Strand{queue};
+	for (std::size_t i = 0; i < tasks.size(); ++i) {
+		tasks.at(i).sequence = &sequence;
+		tasks.at(i).value = int(i);
+		strand.enqueue(tasks.at(i));
+	}
+	strand.wait();
+	EXPECT(is_ordered(sequence.order, tasks.size()));
+	queue.resume();
+}
+
+TEST_CASE(task_strand_rejected_chain) {
+	struct ChainTask : Task {
+		Strand* strand{};
+		ChainTask* next{};
+		std::atomic<int>* executed{};
+
+		void execute() final {
+			++*executed;
+			if (next != nullptr) { strand->enqueue(*next); }
+		}
+	};
+
+	// a full Queue: each Task enqueues the next one, the whole chain runs inline over several turns and nothing is dropped.
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}, .max_elements = ElementCount{1}}};
+	queue.pause();
+	auto blocker = AppendTask{};
+	auto blocker_sequence = Sequence{};
+	blocker.sequence = &blocker_sequence;
+	queue.enqueue(blocker);
+
+	auto strand = Strand{queue};
+	auto executed = std::atomic<int>{};
+	auto chain = std::vector<ChainTask>(200);
+	for (std::size_t i = 0; i < chain.size(); ++i) {
+		chain[i].strand = &strand;
+		chain[i].next = i + 1 < chain.size() ? &chain[i + 1] : nullptr;
+		chain[i].executed = &executed;
+	}
+	strand.enqueue(chain.front());
+	EXPECT(strand.is_idle());
+	EXPECT(executed == int(chain.size()));
+	EXPECT(std::ranges::all_of(chain, [](ChainTask const& task) { return task.get_status() == Status::Completed; }));
+	queue.resume();
+}
+
+TEST_CASE(task_strand_drained) {
+	// the Queue rejects the Strand's next turn while draining: its Tasks still run, in order.
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}}};
+	auto sequence = Sequence{};
+	auto tasks = std::vector<AppendTask>(200);
+	auto strand = Strand{queue};
+	for (std::size_t i = 0; i < tasks.size(); ++i) {
+		tasks[i].sequence = &sequence;
+		tasks[i].value = int(i);
+		strand.enqueue(tasks[i]);
+	}
+	queue.drain_and_wait();
+	strand.wait();
+	EXPECT(!sequence.overlapped);
+	EXPECT(is_ordered(sequence.order, tasks.size()));
+}
+
+TEST_CASE(task_strand_queue_destroyed) {
+	auto sequence = Sequence{};
+	auto tasks = std::array<AppendTask, 3>{};
+	auto queue = std::optional<Queue>{QueueCreateInfo{.thread_count = ThreadCount{1}}};
+	auto strand = Strand{*queue};
+	queue->pause();
+	for (std::size_t i = 0; i < tasks.size(); ++i) {
+		tasks.at(i).sequence = &sequence;
+		tasks.at(i).value = int(i);
+		strand.enqueue(tasks.at(i));
+	}
+	// the dropped turn drops every pending Task instead of re-enqueueing into the dying Queue.
+	queue.reset();
+	EXPECT(strand.is_idle());
+	EXPECT(sequence.order.empty());
+	for (auto const& task : tasks) { EXPECT(task.get_status() == Status::Dropped); }
+}
+
+TEST_CASE(task_strand_cancel) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}}};
+	queue.pause();
+	auto sequence = Sequence{};
+	auto tasks = std::array<AppendTask, 3>{};
+	auto strand = Strand{queue};
+	for (std::size_t i = 0; i < tasks.size(); ++i) {
+		tasks.at(i).sequence = &sequence;
+		tasks.at(i).value = int(i);
+		strand.enqueue(tasks.at(i));
+	}
+	EXPECT(queue.cancel(tasks.at(2)));
+	queue.resume();
+	strand.wait();
+	EXPECT(is_ordered(sequence.order, 2));
+	EXPECT(tasks.at(2).get_status() == Status::Dropped);
+}
+} // namespace
@@ -0,0 +1,127 @@
+#include "klib/task/queue.hpp"
+#include "klib/task/thread_pool.hpp"
+#include "klib/unit_test/unit_test.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace {
+using namespace klib::task;
+
+struct CountTask : Task {
+	std::atomic<int>* executed{};
+
+	void execute() final { ++*executed; }
+};
+
+struct GateTask : Task {
+	std::atomic_bool started{};
+	std::atomic_bool open{};
+
+	void execute() final {
+		started = true;
+		started.notify_all();
+		open.wait(false);
+	}
+};
+
+struct TagTask : Task {
+	inline static std::mutex s_mutex{};
+	inline static std::vector<char> s_order{};
+	char tag{};
+
+	void execute() final {
+		auto lock = std::scoped_lock{s_mutex};
+		s_order.push_back(tag);
+	}
+};
+
+TEST_CASE(task_thread_pool_shared) {
+	auto pool = ThreadPool{ThreadPoolCreateInfo{.thread_count = ThreadCount{2}}};
+	auto io = std::optional<Queue>{QueueCreateInfo{.pool = &pool}};
+	auto compute = Queue{QueueCreateInfo{.thread_count = ThreadCount{8}, .pool = &pool}};
+	EXPECT(pool.queue_count() == 2);
+	EXPECT(compute.thread_count() == pool.thread_count());
+
+	// pause, drain and drop are per Queue.
+	auto executed = std::array<std::atomic<int>, 2>{};
+	auto io_tasks = std::array<CountTask, 8>{};
+	auto compute_tasks = std::array<CountTask, 8>{};
+	io->pause();
+	for (auto& task : io_tasks) {
+		task.executed = &executed[0];
+		EXPECT(io->enqueue(task));
+	}
+	for (auto& task : compute_tasks) {
+		task.executed = &executed[1];
+		EXPECT(compute.enqueue(task));
+	}
+	compute.drain_and_wait();
+	EXPECT(executed[1] == int(compute_tasks.size()));
+	EXPECT(executed[0] == 0);
+	EXPECT(io->enqueued_count() == io_tasks.size());
+	io->drop_enqueued();
+	for (auto const& task : io_tasks) { EXPECT(task.get_status() == Status::Dropped); }
+
+	io->resume();
+	for (auto& task : io_tasks) { EXPECT(io->enqueue(task)); }
+	io->drain_and_wait();
+	EXPECT(executed[0] == int(io_tasks.size()));
+
+	// destroying an attached Queue leaves the pool serving the others.
+	io.reset();
+	EXPECT(pool.queue_count() == 1);
+	for (auto& task : compute_tasks) { EXPECT(compute.enqueue(task)); }
+	compute.drain_and_wait();
+	EXPECT(executed[1] == 2 * int(compute_tasks.size()));
+}
+
+TEST_CASE(task_thread_pool_weight) {
+	auto pool = ThreadPool{ThreadPoolCreateInfo{.thread_count = ThreadCount{1}}};
+	auto heavy = Queue{QueueCreateInfo{.pool = &pool, .weight = 3}};
+	auto light = Queue{QueueCreateInfo{.pool = &pool}};
+	auto gate_queue = Queue{QueueCreateInfo{.pool = &pool}};
+
+	// hold the only worker while both Queues back up.
+	auto gate = GateTask{};
+	EXPECT(gate_queue.enqueue(gate));
+	gate.started.wait(false);
+	TagTask::s_order.clear();
+	auto heavy_tasks = std::array<TagTask, 12>{};
+	auto light_tasks = std::array<TagTask, 12>{};
+	for (auto& task : heavy_tasks) {
+		task.tag = 'h';
+		EXPECT(heavy.enqueue(task));
+	}
+	for (auto& task : light_tasks) {
+		task.tag = 'l';
+		EXPECT(light.enqueue(task));
+	}
+	gate.open = true;
+	gate.open.notify_all();
+	heavy.drain_and_wait();
+	light.drain_and_wait();
+
+	ASSERT(TagTask::s_order.size() == heavy_tasks.size() + light_tasks.size());
+	auto const first = std::vector<char>(TagTask::s_order.begin(), TagTask::s_order.begin() + 8);
+	EXPECT(std::ranges::count(first, 'h') == 6);
+}
+
+TEST_CASE(task_thread_pool_detach_executing) {
+	auto pool = ThreadPool{ThreadPoolCreateInfo{.thread_count = ThreadCount{2}}};
+	auto executed = std::atomic<int>{};
+	auto tasks = std::array<CountTask, 16>{};
+	for (auto& task : tasks) { task.executed = &executed; }
+	// pooled Queues destroyed while workers are still finishing their Tasks.
+	for (auto i = 0; i < 200; ++i) {
+		auto queue = Queue{QueueCreateInfo{.pool = &pool}};
+		for (auto& task : tasks) { EXPECT(queue.enqueue(task)); }
+		for (auto& task : tasks) { task.wait(); }
+	}
+	EXPECT(executed == 200 * int(tasks.size()));
+	EXPECT(pool.queue_count() == 0);
+}
+} // namespace
@@ -0,0 +1,117 @@
+#include "klib/task/queue.hpp"
+#include "klib/unit_test/unit_test.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace klib::task;
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+struct TimedTask : Task {
+	std::atomic<int> executed{};
+	Clock::time_point executed_at{};
+
+	void execute() final {
+		executed_at = Clock::now();
+		++executed;
+	}
+};
+
+auto wait_until_zero(Queue const& queue, Clock::duration const timeout = 5s) -> bool {
+	auto const deadline = Clock::now() + timeout;
+	while (queue.timer_count() > 0) {
+		if (Clock::now() > deadline) { return false; }
+		std::this_thread::sleep_for(1ms);
+	}
+	return true;
+}
+
+TEST_CASE(task_timer_after) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}}};
+	auto task = TimedTask{};
+	auto const start = Clock::now();
+	EXPECT(queue.enqueue_after(task, 20ms) != TimerId::None);
+	EXPECT(queue.timer_count() == 1);
+	ASSERT(wait_until_zero(queue));
+	task.wait();
+	EXPECT(task.executed == 1);
+	EXPECT(task.executed_at - start >= 20ms);
+}
+
+TEST_CASE(task_timer_cancel) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}}};
+	auto task = TimedTask{};
+	auto const id = queue.enqueue_after(task, 50ms);
+	EXPECT(queue.cancel_timer(id));
+	EXPECT(!queue.cancel_timer(id));
+	EXPECT(queue.timer_count() == 0);
+	std::this_thread::sleep_for(80ms);
+	EXPECT(task.executed == 0);
+}
+
+TEST_CASE(task_timer_stale_id) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}}};
+	auto first = TimedTask{};
+	auto const first_id = queue.enqueue_after(first, 1ms);
+	ASSERT(wait_until_zero(queue));
+	first.wait();
+	// the fired timer's storage is reused: its id must not cancel the new one.
+	auto second = TimedTask{};
+	auto const second_id = queue.enqueue_after(second, 1h);
+	EXPECT(second_id != first_id);
+	EXPECT(!queue.cancel_timer(first_id));
+	EXPECT(queue.timer_count() == 1);
+	EXPECT(queue.cancel_timer(second_id));
+}
+
+TEST_CASE(task_timer_earlier) {
+	// a timer added while the timer thread sleeps towards a distant deadline must wake it.
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}}};
+	auto distant = TimedTask{};
+	auto near = TimedTask{};
+	auto const distant_id = queue.enqueue_after(distant, 1h);
+	std::this_thread::sleep_for(5ms);
+	queue.enqueue_after(near, 10ms);
+	auto const deadline = Clock::now() + 5s;
+	while (near.executed == 0 && Clock::now() < deadline) { std::this_thread::sleep_for(1ms); }
+	near.wait();
+	EXPECT(near.executed == 1);
+	EXPECT(distant.executed == 0);
+	EXPECT(queue.cancel_timer(distant_id));
+}
+
+TEST_CASE(task_timer_every) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}}};
+	auto task = TimedTask{};
+	auto const id = queue.enqueue_every(task, 5ms);
+	auto const deadline = Clock::now() + 5s;
+	while (task.executed < 3 && Clock::now() < deadline) { std::this_thread::sleep_for(1ms); }
+	EXPECT(task.executed >= 3);
+	EXPECT(queue.cancel_timer(id));
+	task.wait();
+	auto const executed = task.executed.load();
+	std::this_thread::sleep_for(20ms);
+	EXPECT(task.executed == executed);
+}
+
+TEST_CASE(task_timer_many) {
+	// long delays relative to the resolution are placed in upper levels of the wheel, and cascaded down.
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}, .timer_resolution = 10us}};
+	auto tasks = std::vector<TimedTask>(10'000);
+	auto const start = Clock::now();
+	for (std::size_t i = 0; i < tasks.size(); ++i) { queue.enqueue_at(tasks[i], start + std::chrono::microseconds{i * 10}); }
+	auto const id = queue.enqueue_at(tasks.back(), start + 1h);
+	EXPECT(queue.cancel_timer(id));
+	ASSERT(wait_until_zero(queue));
+	queue.drain_and_wait();
+	auto early = 0;
+	for (std::size_t i = 0; i < tasks.size(); ++i) {
+		EXPECT(tasks[i].executed == 1);
+		if (tasks[i].executed_at < start + std::chrono::microseconds{i * 10}) { ++early; }
+	}
+	EXPECT(early == 0);
+}
+} // namespace
@@ -0,0 +1,74 @@
+#include "klib/task/queue.hpp"
+#include "klib/task/typed_task.hpp"
+#include "klib/unit_test/unit_test.hpp"
+#include <array>
+#include <stdexcept>
+#include <string>
+
+namespace {
+using namespace klib::task;
+
+struct SquareTask : TypedTask<int> {
+	int value{};
+
+	auto compute() -> int final { return value * value; }
+};
+
+struct ThrowTask : TypedTask<void> {
+	void compute() final { throw std::runtime_error{"test"}; }
+};
+
+TEST_CASE(task_typed_result) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{2}}};
+	auto tasks = std::array<SquareTask, 16>{};
+	for (std::size_t i = 0; i < tasks.size(); ++i) {
+		tasks.at(i).value = int(i);
+		queue.enqueue(tasks.at(i));
+	}
+	for (std::size_t i = 0; i < tasks.size(); ++i) {
+		auto const future = tasks.at(i).get_future();
+		EXPECT(future.get() == int(i * i));
+		EXPECT(future.get_status() == Status::Completed);
+	}
+
+	auto func = FuncTask{[] { return std::string{"hello"}; }};
+	queue.enqueue(func);
+	EXPECT(func.get_future().get() == "hello");
+}
+
+TEST_CASE(task_typed_exception) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}}};
+	auto task = ThrowTask{};
+	queue.enqueue(task);
+	task.wait();
+	EXPECT(task.get_exception() != nullptr);
+	auto caught = false;
+	try {
+		task.get_future().get();
+	} catch (std::runtime_error const&) { caught = true; }
+	EXPECT(caught);
+}
+
+TEST_CASE(task_typed_dropped) {
+	auto queue = Queue{QueueCreateInfo{.thread_count = ThreadCount{1}}};
+	queue.pause();
+	auto task = SquareTask{};
+	task.value = 3;
+	queue.enqueue(task);
+	queue.drop_enqueued();
+	EXPECT(task.get_future().get_if() == nullptr);
+	EXPECT(task.get_status() == Status::Dropped);
+
+	// a previous result is not reported for a later run that was dropped.
+	queue.resume();
+	queue.enqueue(task);
+	EXPECT(task.get_future().get() == 9);
+	queue.pause();
+	queue.enqueue(task);
+	EXPECT(task.get_result() == nullptr);
+	queue.drop_enqueued();
+	EXPECT(task.get_status() == Status::Dropped);
+	EXPECT(task.get_result() == nullptr);
+	EXPECT(task.get_future().get_if() == nullptr);
+}
+} // namespace
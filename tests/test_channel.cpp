@@ -0,0 +1,187 @@
+#include "klib/channel.hpp"
+#include "klib/task/queue.hpp"
+#include "klib/unit_test/unit_test.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace klib;
+
+TEST_CASE(channel_non_blocking) {
+	auto channel = Channel<std::unique_ptr<int>, ChannelMode::Spsc>{3};
+	EXPECT(channel.capacity() == 4);
+	EXPECT(channel.is_empty());
+	EXPECT(!channel.try_receive());
+
+	for (auto i = 0; i < 4; ++i) { EXPECT(channel.try_send(std::make_unique<int>(i))); }
+	EXPECT(channel.size() == 4);
+	// rejected value is left untouched.
+	auto extra = std::make_unique<int>(42);
+	EXPECT(!channel.try_send(std::move(extra)));
+	ASSERT(extra);
+
+	auto received = channel.try_receive();
+	ASSERT(received && *received);
+	EXPECT(**received == 0);
+	EXPECT(channel.try_send(std::move(extra)));
+	EXPECT(!extra);
+
+	auto batch = std::array<std::unique_ptr<int>, 8>{};
+	ASSERT(channel.try_receive(batch) == 4);
+	EXPECT(*batch[0] == 1 && *batch[1] == 2 && *batch[2] == 3 && *batch[3] == 42);
+	EXPECT(channel.try_receive(batch) == 0);
+}
+
+TEST_CASE(channel_close) {
+	auto channel = Channel<int>{4};
+	EXPECT(channel.send(1));
+	EXPECT(channel.send(2));
+	channel.close();
+	EXPECT(channel.is_closed());
+	EXPECT(!channel.try_send(3));
+	EXPECT(!channel.send(3));
+
+	// remaining elements are still received.
+	EXPECT(channel.receive() == 1);
+	auto batch = std::array<int, 4>{};
+	EXPECT(channel.receive(batch) == 1);
+	EXPECT(batch[0] == 2);
+	EXPECT(!channel.receive());
+	EXPECT(channel.receive(batch) == 0);
+
+	// blocked receivers and senders are woken.
+	auto empty = Channel<int>{2};
+	auto full = Channel<int>{2};
+	EXPECT(full.send(0) && full.send(1));
+	auto received = std::optional<int>{0};
+	auto sent = true;
+	{
+		auto receiver = std::jthread{[&] { received = empty.receive(); }};
+		auto sender = std::jthread{[&] { sent = full.send(2); }};
+		std::this_thread::sleep_for(std::chrono::milliseconds{5});
+		empty.close();
+		full.close();
+	}
+	EXPECT(!received);
+	EXPECT(!sent);
+}
+
+TEST_CASE(channel_spsc_stream) {
+	static constexpr auto count_v = 20'000;
+	auto channel = Channel<int, ChannelMode::Spsc>{16};
+	auto producer = std::jthread{[&] {
+		for (auto i = 0; i < count_v; ++i) { EXPECT(channel.send(i)); }
+		channel.close();
+	}};
+
+	auto expected = 0;
+	auto batch = std::array<int, 8>{};
+	for (auto count = channel.receive(batch); count > 0; count = channel.receive(batch)) {
+		for (auto i = std::size_t{}; i < count; ++i) { EXPECT(batch[i] == expected++); }
+	}
+	EXPECT(expected == count_v);
+}
+
+TEST_CASE(channel_mpmc_stream) {
+	static constexpr auto producers_v = 4;
+	static constexpr auto consumers_v = 3;
+	static constexpr auto per_producer_v = 5'000;
+	auto channel = Channel<int>{32};
+	auto received = std::vector<std::atomic<int>>(producers_v * per_producer_v);
+	{
+		auto consumers = std::vector<std::jthread>{};
+		for (auto c = 0; c < consumers_v; ++c) {
+			consumers.emplace_back([&, c] {
+				// FIFO per producer, as seen by each consumer.
+				auto last = std::array<int, producers_v>{};
+				last.fill(-1);
+				auto batch = std::array<int, 4>{};
+				auto receive = [&](int const value) {
+					++received.at(std::size_t(value));
+					auto& prev = last.at(std::size_t(value / per_producer_v));
+					EXPECT(value > prev);
+					prev = value;
+				};
+				while (true) {
+					if (c == 0) {
+						auto value = channel.receive();
+						if (!value) { break; }
+						receive(*value);
+					} else {
+						auto const count = channel.receive(batch);
+						if (count == 0) { break; }
+						for (auto i = std::size_t{}; i < count; ++i) { receive(batch[i]); }
+					}
+				}
+			});
+		}
+		{
+			auto producers = std::vector<std::jthread>{};
+			for (auto p = 0; p < producers_v; ++p) {
+				producers.emplace_back([&, p] {
+					for (auto i = 0; i < per_producer_v; ++i) {
+						auto const value = (p * per_producer_v) + i;
+						if (channel.try_send(value)) { continue; }
+						EXPECT(channel.send(value));
+					}
+				});
+			}
+		}
+		channel.close();
+	}
+	for (auto const& count : received) { EXPECT(count == 1); }
+}
+
+TEST_CASE(channel_notifier) {
+	static constexpr auto producers_v = 4;
+	static constexpr auto per_producer_v = 1'000;
+
+	struct DrainTask : task::Task {
+		Channel<int>* channel{};
+		std::atomic<bool>* gate{};
+		int sum{};
+		int runs{};
+
+		void execute() final {
+			// the first run holds the consumer up until the whole burst has been sent.
+			if (++runs == 1) { gate->wait(false); }
+			auto batch = std::array<int, 16>{};
+			for (auto count = channel->try_receive(batch); count > 0; count = channel->try_receive(batch)) {
+				for (auto i = std::size_t{}; i < count; ++i) { sum += batch[i]; }
+			}
+		}
+	};
+
+	auto queue = task::Queue{};
+	// room for the whole burst: producers never block on the held up consumer.
+	auto channel = Channel<int>{producers_v * per_producer_v};
+	auto gate = std::atomic<bool>{};
+	auto drain = DrainTask{};
+	drain.channel = &channel;
+	drain.gate = &gate;
+	auto notifier = task::Notifier{queue, drain};
+	channel.set_notifier(&notifier);
+	EXPECT(notifier.is_idle());
+	{
+		auto producers = std::vector<std::jthread>{};
+		for (auto p = 0; p < producers_v; ++p) {
+			producers.emplace_back([&] {
+				for (auto i = 1; i <= per_producer_v; ++i) { EXPECT(channel.send(i)); }
+			});
+		}
+	}
+	gate = true;
+	gate.notify_all();
+	notifier.wait();
+	EXPECT(notifier.is_idle());
+	EXPECT(channel.is_empty());
+	EXPECT(drain.sum == producers_v * (per_producer_v * (per_producer_v + 1) / 2));
+	// every notification sent while the first run was held up is coalesced into (at most) one more run.
+	EXPECT(drain.runs >= 1 && drain.runs <= 2);
+}
+} // namespace